@@ -0,0 +1,257 @@
+#include "../include/Simulation.hpp"
+#include "../include/StuckKnifeStore.hpp"
+#include "../include/ParticleSystem.hpp"
+#include "../include/Target.hpp"
+#include "../include/Renderer.hpp"
+#include "../include/FontManager.hpp"
+#include "../include/GameConstants.hpp"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Microbenchmarks for the gameplay, text and particle hot paths, each run at
+// a range of stuck-knife (or live particle) counts. Results go to a JSON file so runs before and after
+// a change can be diffed. Build with the default log level so debug logging
+// in the hot paths is compiled out, as in a shipped build.
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct BenchResult {
+        std::string name;
+        int stuckKnives;
+        int particles;
+        long long iterations;
+        double nsPerOpMedian;
+        double nsPerOpMin;
+    };
+
+    struct BenchConfig {
+        std::vector<int> knifeCounts = { 6, 64, 256, 1000, 4000, 10000 };
+        std::vector<int> particleCounts = { 1000, 4000, 8000 };
+        double minSampleMs = 20.0;  // Each timed sample runs at least this long
+        int samples = 5;
+        std::string outPath = "bench_results.json";
+    };
+
+    volatile float sink = 0.0f;
+
+    template <typename Fn>
+    BenchResult measure(const std::string& name, int stuckKnives, const BenchConfig& config, Fn fn,
+        int particles = 0) {
+        // Calibrate: double the batch until one batch fills a sample
+        long long batch = 1;
+        for (;;) {
+            auto start = Clock::now();
+            for (long long i = 0; i < batch; i++) fn();
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+            if (ms >= config.minSampleMs || batch >= (1LL << 40)) break;
+            batch *= 2;
+        }
+
+        std::vector<double> nsPerOp;
+        for (int s = 0; s < config.samples; s++) {
+            auto start = Clock::now();
+            for (long long i = 0; i < batch; i++) fn();
+            double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            nsPerOp.push_back(ns / batch);
+        }
+        std::sort(nsPerOp.begin(), nsPerOp.end());
+
+        BenchResult result = { name, stuckKnives, particles, batch * config.samples,
+            nsPerOp[nsPerOp.size() / 2], nsPerOp.front() };
+        std::cerr << name << " [" << (particles > 0 ? particles : stuckKnives)
+            << (particles > 0 ? " particles]: " : " knives]: ")
+            << result.nsPerOpMedian << " ns/op (min " << result.nsPerOpMin << ")" << std::endl;
+        return result;
+    }
+
+    // Spread knives over the top half of the rim; the incoming knife arrives
+    // at the bottom, so collision checks walk every knife without a hit
+    void populate(Simulation& simulation, int count) {
+        for (int i = 0; i < count; i++) {
+            simulation.placeStuckKnife(180.0f + 180.0f * i / count);
+        }
+    }
+
+    // Keep the pool at count live particles, replacing the ones that expired
+    // with a steady mix of chips and sparks, as during heavy play
+    void topUp(ParticleSystem& particles, int count) {
+        int missing = count - static_cast<int>(particles.getCount());
+        int chips = missing / 2;
+        if (chips > 0) {
+            particles.emitWoodChips(GameConstants::TARGET_X, GameConstants::TARGET_Y + GameConstants::TARGET_RADIUS,
+                0.0f, 1.0f, chips);
+        }
+        if (missing - chips > 0) {
+            particles.emitSparks(GameConstants::TARGET_X, GameConstants::TARGET_Y, missing - chips);
+        }
+    }
+
+    std::vector<int> parseCounts(const char* list) {
+        std::vector<int> counts;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            int count = atoi(item.c_str());
+            if (count > 0) counts.push_back(count);
+        }
+        return counts;
+    }
+
+    bool writeJSON(const std::string& path, const std::vector<BenchResult>& results) {
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "Failed to open " << path << " for writing" << std::endl;
+            return false;
+        }
+
+        file << "{\n  \"benchmark\": \"KnifeHitBench\",\n";
+        file << "  \"tick_rate\": " << GameConstants::SIMULATION_TICK_RATE << ",\n";
+        file << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            file << "    { \"name\": \"" << r.name << "\", \"stuck_knives\": " << r.stuckKnives
+                << ", \"particles\": " << r.particles
+                << ", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << r.nsPerOpMedian
+                << ", \"ns_per_op_min\": " << r.nsPerOpMin << " }"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            config.outPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--counts") == 0 && i + 1 < argc) {
+            config.knifeCounts = parseCounts(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--particles") == 0 && i + 1 < argc) {
+            config.particleCounts = parseCounts(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            config.minSampleMs = atof(argv[++i]);
+        }
+    }
+
+    // Offscreen software renderer for the text path; only fonts are needed
+    SDL_Surface* surface = SDL_CreateSurface(GameConstants::SCREEN_WIDTH,
+        GameConstants::SCREEN_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+    Renderer* renderer = surface ? new Renderer(surface) : nullptr;
+    bool haveSprites = renderer && renderer->initialize();
+    if (renderer && !haveSprites) {
+        std::cerr << "Renderer initialization incomplete, continuing for text benchmarks" << std::endl;
+    }
+    bool haveText = renderer && FontManager::getInstance().getFont(FontManager::UI_FONT) != nullptr;
+
+    std::vector<BenchResult> results;
+    const float dt = GameConstants::FIXED_TIMESTEP;
+
+    for (int count : config.knifeCounts) {
+        Simulation simulation;
+        simulation.reset(1);
+        populate(simulation, count);
+
+        const Target& target = simulation.getTarget();
+        float incomingX = target.getX();
+        float incomingY = target.getY() + target.getRadius();
+
+        results.push_back(measure("Simulation::checkKnifeCollision", count, config, [&]() {
+            sink = sink + simulation.checkKnifeCollision(incomingX, incomingY);
+        }));
+
+        results.push_back(measure("Simulation::updateStuckKnives", count, config, [&]() {
+            simulation.updateStuckKnives();
+        }));
+
+        StuckKnifeStore knives = simulation.getStuckKnives();
+        float rotation = 0.0f;
+        results.push_back(measure("StuckKnifeStore::update", count, config, [&]() {
+            rotation += 0.75f;
+            knives.update(target.getX(), target.getY(), rotation);
+            sink = sink + knives.getX(knives.size() - 1);
+        }));
+
+        results.push_back(measure("StuckKnifeStore::updateScalar", count, config, [&]() {
+            rotation += 0.75f;
+            knives.updateScalar(target.getX(), target.getY(), rotation);
+            sink = sink + knives.getX(knives.size() - 1);
+        }));
+
+        Target spinning = target;
+        results.push_back(measure("Target::update", count, config, [&]() {
+            spinning.update(dt);
+            sink = sink + spinning.getRotation();
+        }));
+
+        if (haveText) {
+            // Frames of TEXT_PER_FRAME draws, so queued commands are flushed as in
+            // the game while clear and present stay a small share of each op
+            const int TEXT_PER_FRAME = 16;
+            std::string scoreText = std::to_string(count * GameConstants::POINTS_PER_KNIFE);
+            int drawn = 0;
+            renderer->clear();
+            results.push_back(measure("Renderer::renderText", count, config, [&]() {
+                renderer->renderText(scoreText, GameConstants::SCREEN_WIDTH - 100, 40,
+                    { 255, 255, 255, 255 }, true, FontManager::SCORE_FONT);
+                if (++drawn == TEXT_PER_FRAME) {
+                    renderer->present();
+                    renderer->clear();
+                    drawn = 0;
+                }
+            }));
+            renderer->present();
+        }
+    }
+
+    // Particle stress: a full pool updated and drawn every frame. The draw
+    // goes through the software renderer, so it includes the fill cost.
+    for (int count : config.particleCounts) {
+        ParticleSystem particles(static_cast<size_t>(count));
+        topUp(particles, count);
+
+        results.push_back(measure("ParticleSystem::update", 0, config, [&]() {
+            particles.update(dt);
+            topUp(particles, count);
+            sink = sink + particles.getX(0);
+        }, count));
+
+        if (haveSprites) {
+            results.push_back(measure("Renderer::renderParticles", 0, config, [&]() {
+                renderer->clear();
+                renderer->renderParticles(particles);
+                renderer->present();
+            }, count));
+        }
+    }
+
+    if (haveText) {
+        const TextCache::Stats& text = renderer->getTextCacheStats();
+        std::cerr << "Text cache: " << text.hits << " hits, " << text.misses << " misses, "
+            << text.entries << " entries, " << text.bytes << " bytes" << std::endl;
+    }
+
+    delete renderer;
+    FontManager::getInstance().cleanup();
+    if (surface) SDL_DestroySurface(surface);
+    SDL_Quit();
+
+    if (!writeJSON(config.outPath, results)) {
+        return 1;
+    }
+    std::cout << "Wrote " << results.size() << " results to " << config.outPath << std::endl;
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "../include/FontManager.hpp"
+#include <SDL3/SDL.h>
+#include <iostream>
+
+// Checks the font cache's memory cap: with a cap smaller than any variant,
+// loading one has to evict the rest, and an evicted variant has to load
+// again on its next use. Fonts come from the baked sheets or the TTFs, so
+// run from the repository root like the game.
+
+namespace {
+    bool check(bool condition, const char* what) {
+        std::cerr << what << (condition ? ": ok" : ": FAILED") << std::endl;
+        return condition;
+    }
+}
+
+int main() {
+    FontManager& fonts = FontManager::getInstance();
+    if (!fonts.initialize()) {
+        std::cerr << "Failed to load the fonts" << std::endl;
+        SDL_Quit();
+        return 1;
+    }
+
+    size_t previousCap = fonts.getMaxBytes();
+    unsigned long long evictionsBefore = fonts.getEvictionCount();
+    fonts.setMaxBytes(1);
+
+    bool passed = check(fonts.getAtlas(FontManager::DEBUG_FONT) != nullptr, "DEBUG loads under the cap");
+    passed = check(!fonts.isLoaded(FontManager::TITLE_FONT), "loading DEBUG evicts TITLE") && passed;
+    passed = check(fonts.getEvictionCount() > evictionsBefore, "evictions are counted") && passed;
+    GlyphAtlas* title = fonts.getAtlas(FontManager::TITLE_FONT);
+    passed = check(title != nullptr, "TITLE reloads after eviction") && passed;
+    passed = check(!fonts.isLoaded(FontManager::DEBUG_FONT), "reloading TITLE evicts DEBUG") && passed;
+    passed = check(title && fonts.getLoadedBytes() == title->getMemoryBytes(), "only TITLE is counted") && passed;
+
+    fonts.setMaxBytes(previousCap);
+    fonts.cleanup();
+    SDL_Quit();
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,291 @@
+#include "../include/Renderer.hpp"
+#include "../include/Target.hpp"
+#include "../include/Knife.hpp"
+#include "../include/ParticleSystem.hpp"
+#include "../include/FontManager.hpp"
+#include "../include/GameConstants.hpp"
+#include <SDL3/SDL.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Renders every screen through the offscreen software renderer, so it runs
+// on machines without a GPU or display. Each screen is timed (frames per
+// second go to a JSON file, like KnifeHitBench) and its frame is compared
+// with a golden BMP. Run with --update-golden to create the goldens, and
+// again after an intended visual change. A screen without a golden fails
+// unless --allow-missing-golden is given. Goldens live in the source tree's
+// bench/golden unless --golden names another directory.
+
+// Set by CMake so the goldens are found from any working directory
+#ifndef KNIFEHIT_SOURCE_DIR
+#define KNIFEHIT_SOURCE_DIR "."
+#endif
+
+namespace {
+    using Clock = std::chrono::steady_clock;
+
+    struct CheckConfig {
+        std::string goldenDir = KNIFEHIT_SOURCE_DIR "/bench/golden";
+        std::string outDir = ".";      // Frames that fail the comparison are written here
+        std::string outPath = "render_results.json";
+        int channelTolerance = 8;      // Per-channel difference still counted as a match
+        double maxMismatchPercent = 0.5;  // Share of pixels allowed to differ beyond that
+        double minSampleMs = 500.0;    // Each screen is timed for at least this long
+        float renderScale = 1.0f;      // Playfield resolution, see Renderer::setRenderScale
+        bool updateGolden = false;
+        bool allowMissingGolden = false;  // Report screens without a golden instead of failing them
+    };
+
+    struct Screen {
+        const char* name;
+        std::function<void(Renderer&)> draw;
+    };
+
+    struct CheckResult {
+        std::string name;
+        int frames;
+        double fps;
+        double mismatchPercent;  // -1 when there was nothing to compare against
+        bool hasGolden;
+        bool passed;
+    };
+
+    // Fixed scene: a level-3 style target with knives around the rim, turned
+    // so none of them are axis-aligned
+    void buildScene(Target& target, int stuckKnives) {
+        for (int i = 0; i < stuckKnives; i++) {
+            target.addStuckKnife(25.0f + 360.0f * i / stuckKnives, GameConstants::TARGET_RADIUS);
+        }
+        target.setRotation(37.0f);
+        target.updateStuckKnives();
+    }
+
+    // Fraction of pixels whose largest channel difference exceeds the tolerance
+    double comparePixels(SDL_Surface* actual, SDL_Surface* golden, int tolerance) {
+        long long mismatched = 0;
+        for (int y = 0; y < actual->h; y++) {
+            const Uint32* a = reinterpret_cast<const Uint32*>(static_cast<Uint8*>(actual->pixels) + y * actual->pitch);
+            const Uint32* g = reinterpret_cast<const Uint32*>(static_cast<Uint8*>(golden->pixels) + y * golden->pitch);
+            for (int x = 0; x < actual->w; x++) {
+                int worst = 0;
+                for (int shift = 0; shift < 32; shift += 8) {
+                    int delta = std::abs(static_cast<int>((a[x] >> shift) & 0xFF) - static_cast<int>((g[x] >> shift) & 0xFF));
+                    worst = std::max(worst, delta);
+                }
+                if (worst > tolerance) mismatched++;
+            }
+        }
+        return 100.0 * mismatched / (static_cast<double>(actual->w) * actual->h);
+    }
+
+    CheckResult checkScreen(Renderer& renderer, const Screen& screen, const CheckConfig& config) {
+        CheckResult result = { screen.name, 0, 0.0, -1.0, false, false };
+
+        // Time whole frames, draw through present
+        auto start = Clock::now();
+        double elapsedMs = 0.0;
+        while (elapsedMs < config.minSampleMs) {
+            screen.draw(renderer);
+            renderer.present();
+            result.frames++;
+            elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        }
+        result.fps = result.frames * 1000.0 / elapsedMs;
+
+        screen.draw(renderer);
+        SDL_Surface* frame = renderer.readPixels();
+        SDL_Surface* actual = frame ? SDL_ConvertSurface(frame, SDL_PIXELFORMAT_ARGB8888) : nullptr;
+        if (frame) SDL_DestroySurface(frame);
+        renderer.present();
+        if (!actual) {
+            std::cerr << screen.name << ": failed to read back the frame: " << SDL_GetError() << std::endl;
+            return result;
+        }
+
+        std::string goldenPath = config.goldenDir + "/" + screen.name + ".bmp";
+        if (config.updateGolden) {
+            result.passed = SDL_SaveBMP(actual, goldenPath.c_str());
+            result.hasGolden = result.passed;
+            if (!result.passed) {
+                std::cerr << "Failed to write " << goldenPath << ": " << SDL_GetError() << std::endl;
+            }
+            SDL_DestroySurface(actual);
+            return result;
+        }
+
+        SDL_Surface* loaded = SDL_LoadBMP(goldenPath.c_str());
+        SDL_Surface* golden = loaded ? SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_ARGB8888) : nullptr;
+        if (loaded) SDL_DestroySurface(loaded);
+
+        if (!golden) {
+            // Otherwise a checkout without goldens would pass without comparing anything
+            std::cerr << screen.name << ": no golden image at " << goldenPath
+                << " (run with --update-golden to create it)" << std::endl;
+            result.passed = config.allowMissingGolden;
+        }
+        else if (golden->w != actual->w || golden->h != actual->h) {
+            std::cerr << screen.name << ": golden is " << golden->w << "x" << golden->h
+                << ", frame is " << actual->w << "x" << actual->h << std::endl;
+        }
+        else {
+            result.hasGolden = true;
+            result.mismatchPercent = comparePixels(actual, golden, config.channelTolerance);
+            result.passed = result.mismatchPercent <= config.maxMismatchPercent;
+        }
+
+        // Keep the failing frame so it can be inspected or promoted to golden
+        if (!result.passed) {
+            std::string failedPath = config.outDir + "/" + screen.name + ".actual.bmp";
+            SDL_SaveBMP(actual, failedPath.c_str());
+        }
+
+        if (golden) SDL_DestroySurface(golden);
+        SDL_DestroySurface(actual);
+        return result;
+    }
+
+    bool writeJSON(const std::string& path, const CheckConfig& config, const std::vector<CheckResult>& results) {
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "Failed to open " << path << " for writing" << std::endl;
+            return false;
+        }
+
+        file << "{\n  \"benchmark\": \"KnifeHitRenderCheck\",\n";
+        file << "  \"width\": " << GameConstants::SCREEN_WIDTH
+            << ", \"height\": " << GameConstants::SCREEN_HEIGHT
+            << ", \"render_scale\": " << config.renderScale << ",\n";
+        file << "  \"results\": [\n";
+        for (size_t i = 0; i < results.size(); i++) {
+            const CheckResult& r = results[i];
+            file << "    { \"name\": \"" << r.name << "\", \"frames\": " << r.frames
+                << ", \"fps\": " << r.fps
+                << ", \"has_golden\": " << (r.hasGolden ? "true" : "false")
+                << ", \"mismatch_percent\": " << r.mismatchPercent
+                << ", \"passed\": " << (r.passed ? "true" : "false") << " }"
+                << (i + 1 < results.size() ? "," : "") << "\n";
+        }
+        file << "  ]\n}\n";
+        return static_cast<bool>(file);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    CheckConfig config;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--golden") == 0 && i + 1 < argc) {
+            config.goldenDir = argv[++i];
+        }
+        else if (strcmp(argv[i], "--out-dir") == 0 && i + 1 < argc) {
+            config.outDir = argv[++i];
+        }
+        else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            config.outPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--tolerance") == 0 && i + 1 < argc) {
+            config.channelTolerance = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--max-diff-percent") == 0 && i + 1 < argc) {
+            config.maxMismatchPercent = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--min-time-ms") == 0 && i + 1 < argc) {
+            config.minSampleMs = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--render-scale") == 0 && i + 1 < argc) {
+            config.renderScale = static_cast<float>(atof(argv[++i]));
+        }
+        else if (strcmp(argv[i], "--update-golden") == 0) {
+            config.updateGolden = true;
+        }
+        else if (strcmp(argv[i], "--allow-missing-golden") == 0) {
+            config.allowMissingGolden = true;
+        }
+    }
+
+    // Neither directory has to exist yet; SDL_CreateDirectory also succeeds if it does
+    if ((config.updateGolden && !SDL_CreateDirectory(config.goldenDir.c_str())) ||
+        !SDL_CreateDirectory(config.outDir.c_str())) {
+        std::cerr << "Failed to create the output directories: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    SDL_Surface* surface = SDL_CreateSurface(GameConstants::SCREEN_WIDTH,
+        GameConstants::SCREEN_HEIGHT, SDL_PIXELFORMAT_ARGB8888);
+    Renderer* renderer = surface ? new Renderer(surface) : nullptr;
+    if (!renderer || !renderer->initialize()) {
+        std::cerr << "Failed to create the offscreen renderer: " << SDL_GetError() << std::endl;
+        delete renderer;
+        if (surface) SDL_DestroySurface(surface);
+        SDL_Quit();
+        return 1;
+    }
+    // The prompt pulse would otherwise make every capture different
+    renderer->setAnimationTime(0);
+    renderer->setRenderScale(config.renderScale);
+
+    Target target;
+    Knife knife;
+    buildScene(target, 7);
+
+    // Incoming knife just short of the rim, as when the pause starts. The
+    // simulation sticks it last, and the pause screen leaves that one out.
+    Knife hitKnife;
+    hitKnife.setY(target.getY() + target.getRadius() + GameConstants::KNIFE_LENGTH / 2);
+    Target collisionTarget;
+    buildScene(collisionTarget, 7);
+    collisionTarget.addStuckKnife(90.0f, GameConstants::TARGET_RADIUS);
+    collisionTarget.updateStuckKnives();
+
+    // A hit and a collision a few frames in; the particle RNG is fixed, so
+    // these land in the same place every run
+    ParticleSystem hitChips;
+    hitChips.emitWoodChips(target.getX(), target.getY() + target.getRadius(), 0.0f, 1.0f,
+        GameConstants::WOOD_CHIPS_PER_HIT);
+    hitChips.update(0.05f);
+    ParticleSystem collisionSparks;
+    collisionSparks.emitSparks(hitKnife.getX(), hitKnife.getY(), GameConstants::SPARKS_PER_COLLISION);
+    collisionSparks.emitKnife(hitKnife.getX(), hitKnife.getY() + GameConstants::KNIFE_LENGTH / 2);
+    collisionSparks.update(0.05f);
+
+    const Screen screens[] = {
+        { "menu", [](Renderer& r) { r.renderMenu(); } },
+        { "game", [&](Renderer& r) { r.renderGame(target, target.getRotation(), knife, knife.getY(), hitChips, 3, 42, 5); } },
+        { "collision_pause", [&](Renderer& r) { r.renderCollisionPause(collisionTarget, collisionTarget.getRotation(), hitKnife, collisionSparks, 3, 42, 5); } },
+        { "game_over", [](Renderer& r) { r.renderGameOver(42); } },
+        { "level_complete", [](Renderer& r) { r.renderLevelComplete(); } },
+    };
+
+    std::vector<CheckResult> results;
+    bool allPassed = true;
+    for (const Screen& screen : screens) {
+        CheckResult result = checkScreen(*renderer, screen, config);
+        std::cerr << result.name << ": " << result.fps << " FPS";
+        if (result.mismatchPercent >= 0.0) {
+            std::cerr << ", " << result.mismatchPercent << "% pixels differ";
+        }
+        else if (!result.hasGolden) {
+            std::cerr << ", not compared";
+        }
+        std::cerr << (result.passed ? "" : "  FAILED") << std::endl;
+        allPassed = allPassed && result.passed;
+        results.push_back(result);
+    }
+
+    delete renderer;
+    FontManager::getInstance().cleanup();
+    SDL_DestroySurface(surface);
+    SDL_Quit();
+
+    if (!writeJSON(config.outPath, config, results)) {
+        return 1;
+    }
+    std::cout << "Wrote " << results.size() << " results to " << config.outPath << std::endl;
+    return allPassed ? 0 : 1;
+}
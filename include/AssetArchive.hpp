@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class AssetType : uint8_t {
+    IMAGE = 1,  // Decoded pixels, ready for SDL_CreateSurfaceFrom
+    FONT = 2,   // Font file bytes, opened from memory
+    BAKED_FONT = 3  // Baked glyph sheet, see GlyphAtlas::loadBaked
+};
+
+// One asset as it sits in the mapped archive. data points into the mapping
+// and stays valid until the archive is closed.
+struct AssetEntry {
+    AssetType type;
+    const void* data;
+    size_t size;
+    uint32_t pixelFormat;  // SDL_PixelFormat value, images only
+    int width;
+    int height;
+    int pitch;
+};
+
+// An asset to be written by AssetArchive::write
+struct PackedAsset {
+    std::string name;  // The path the asset is loaded from without an archive
+    AssetEntry info;   // data/size are ignored; bytes is written instead
+    std::vector<uint8_t> bytes;
+};
+
+// Single-file asset pack, memory-mapped read-only. Images are stored already
+// decoded and fonts as raw files, each 64-byte aligned, so loading an asset
+// is a lookup that hands back a pointer into the mapping: no reads, decodes
+// or copies. Assets are looked up by their loose-file path, so callers fall
+// back to the file when the archive doesn't have it.
+class AssetArchive {
+public:
+    AssetArchive();
+    ~AssetArchive();
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    const AssetEntry* find(const std::string& name) const;  // nullptr if not packed
+    size_t getEntryCount() const { return entries.size(); }
+
+    static bool write(const std::string& path, const std::vector<PackedAsset>& assets);
+
+private:
+    AssetArchive(const AssetArchive&) = delete;
+    AssetArchive& operator=(const AssetArchive&) = delete;
+
+    bool parse(const std::string& path);
+
+    const uint8_t* mapping;
+    size_t mappingSize;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#else
+    int fileDescriptor;
+#endif
+    std::unordered_map<std::string, AssetEntry> entries;
+};
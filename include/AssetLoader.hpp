@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Small worker pool for startup loading. Jobs run in any order on any
+// worker, so each one writes only its own result slot; the owner reads the
+// results once isFinished() is true. SDL-free: jobs decide what they load.
+class AssetLoader {
+public:
+    static constexpr unsigned int MAX_THREADS = 4;  // Startup has only a handful of assets
+
+    explicit AssetLoader(unsigned int threadCount = 0);  // 0: one per core, up to MAX_THREADS
+    ~AssetLoader();  // Drops jobs that haven't started, then joins the workers
+
+    void submit(std::function<void()> job);
+    void wait();  // Block until every submitted job has run
+
+    bool isFinished() const;
+    float getProgress() const;  // Completed share of the submitted jobs, 0 to 1
+    size_t getThreadCount() const { return workers.size(); }
+
+private:
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> queue;
+    mutable std::mutex mutex;
+    std::condition_variable jobAvailable;
+    std::condition_variable jobDone;
+    size_t submitted;
+    size_t completed;
+    bool stopping;
+};
@@ -1,35 +1,133 @@
 #pragma once
 
 #include <SDL3/SDL.h>
-#include <SDL3_ttf/SDL_ttf.h>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
+#include "GlyphAtlas.hpp"
+#include "TtfSupport.hpp"
 
+class AssetArchive;
+class AssetLoader;
+
+// Index of a (face, size) variant, resolved once with getHandle and cheap
+// to pass on every draw
+typedef int FontHandle;
+
+// Font files; the (face, size) variants drawn from them are opened lazily
+enum class FontFace {
+    FREDOKA_BOLD,
+    RUBIK_MEDIUM,
+    RUBIK_BOLD,
+    RUBIK_REGULAR,
+    COUNT
+};
+
+// A variant's glyph atlas is loaded the first time it is drawn with: from
+// its baked sheet if bake_fonts made one, otherwise built from the TTF.
+// FreeType is only started for a variant without a sheet, or for text the
+// atlas can't draw. Variants not used recently are closed again once the
+// atlases add up to more than the memory cap; the handle stays valid and
+// reloads the variant when next used.
 class FontManager {
 public:
+    static constexpr FontHandle INVALID_FONT = -1;
+    static constexpr size_t DEFAULT_MAX_BYTES = 8 * 1024 * 1024;
+
+    // Built-in styles, registered in this order on construction
+    static constexpr FontHandle TITLE_FONT = 0;  // Bold and chunky for KNIFE HIT, GAME OVER, etc.
+    static constexpr FontHandle UI_FONT = 1;     // Medium weight for TAP TO PLAY, STAGE X, etc.
+    static constexpr FontHandle SCORE_FONT = 2;  // Bold for numbers
+    static constexpr FontHandle DEBUG_FONT = 3;  // Small, for the profiler overlay
+
     static FontManager& getInstance() {
         static FontManager instance;
         return instance;
     }
 
-    bool initialize();
+    // Fonts found in archive are opened from its mapping, the rest from disk;
+    // the archive must outlive cleanup(). The styles the first screens draw
+    // with are loaded up front, everything else on first use.
+    bool initialize(const AssetArchive* archive = nullptr);
+    // Same, split: loadAsync queues each up-front style (open plus glyph
+    // atlas) on the loader; finishLoading registers them once it has finished
+    bool loadAsync(AssetLoader& loader, const AssetArchive* archive = nullptr);
+    bool finishLoading();
     void cleanup();
 
-    // Font loading
-    bool loadFont(const std::string& name, const std::string& path, int size);
-    TTF_Font* getFont(const std::string& name);
+    // Handle for face at size in pixels, registering the variant if it's new;
+    // nothing is loaded until the handle is drawn with
+    FontHandle getHandle(FontFace face, int size);
+    static std::vector<std::string> getFontPaths();  // Every face file, for the asset packer
+    static std::string getFacePath(FontFace face);
+    static std::string getBakedName(FontFace face, int size);  // Sheet file name, also its name in the archive
+    static std::string getBakedDirectory();  // Where bake_fonts writes the sheets
+    static std::vector<std::pair<FontFace, int>> getBuiltInStyles();  // The variants worth baking
 
-    // Predefined font names
-    static constexpr const char* TITLE_FONT = "title";
-    static constexpr const char* UI_FONT = "ui";
-    static constexpr const char* SCORE_FONT = "score";
+    // TTF font of the variant, opened on first call; only needed for text the
+    // glyph atlas can't draw. nullptr if it failed to open or TTF is compiled out.
+    TTF_Font* getFont(FontHandle handle);
+    // Glyph atlas of the variant, loading it if needed; nullptr if it has none.
+    // Textures are created on load once createAtlasTextures has given a renderer.
+    GlyphAtlas* getAtlas(FontHandle handle);
+    void createAtlasTextures(SDL_Renderer* renderer);
+    void destroyAtlasTextures();  // Also stops lazy texture creation
+
+    // The cap covers glyph atlases and open TTF faces, the latter estimated
+    // as their file size; it's enforced whenever a variant loads
+    void setMaxBytes(size_t bytes) { maxBytes = bytes; }
+    size_t getMaxBytes() const { return maxBytes; }
+    size_t getLoadedBytes() const { return loadedBytes; }
+    bool isLoaded(FontHandle handle) const;
+    unsigned long long getEvictionCount() const { return evictions; }
 
 private:
-    FontManager() = default;
+    struct LoadedFont {
+        TTF_Font* font = nullptr;
+        size_t fontBytes = 0;
+        std::unique_ptr<GlyphAtlas> atlas;
+    };
+
+    struct Variant {
+        FontFace face;
+        int size;
+        LoadedFont loaded;
+        size_t bytes;
+        unsigned long long lastUse;  // useClock when last drawn with, for eviction
+        bool failed;                 // Don't retry a font that failed to load every frame
+        bool fontFailed;             // Same for the TTF fallback
+    };
+
+    struct PendingFont {
+        FontHandle handle;
+        LoadedFont loaded;
+    };
+
+    FontManager();
     ~FontManager() { cleanup(); }
 
     FontManager(const FontManager&) = delete;
     FontManager& operator=(const FontManager&) = delete;
 
-    std::unordered_map<std::string, TTF_Font*> fonts;
+    // Baked sheet, else an atlas built from the TTF, which is then closed
+    // again unless the atlas failed. Touches no manager state, so it can
+    // run on a loader thread.
+    static bool openFont(FontFace face, int size, const AssetArchive* archive, LoadedFont& loaded);
+    static TTF_Font* openTtf(FontFace face, int size, const AssetArchive* archive, size_t& bytes);
+    Variant* use(FontHandle handle);  // Loaded variant, or nullptr
+    void install(Variant& variant, LoadedFont& loaded);
+    void unload(Variant& variant);
+    void evict(FontHandle keep);
+
+    std::vector<Variant> variants;  // Indexed by handle; never shrinks
+    std::vector<PendingFont> pendingFonts;  // Filled by loader jobs, one slot per font
+    const AssetArchive* archive;
+    SDL_Renderer* atlasRenderer;  // Set while atlas textures may be created
+    bool initialized;  // Between initialize/loadAsync and cleanup; no lazy loads outside
+    size_t maxBytes;
+    size_t loadedBytes;
+    unsigned long long useClock;
+    unsigned long long evictions;
 };
\ No newline at end of file
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+class Renderer;
+
+enum class PacingMode {
+    VSYNC,  // Present blocks on the display's vertical blank
+    SLEEP   // Sleep until a fixed deadline after each frame
+};
+
+// Keeps frames evenly spaced at a target rate. When the rate is the display
+// refresh rate (or a whole divisor of it) present() does the waiting through
+// vsync; otherwise, or without vsync, the loop sleeps until the next
+// deadline. Frame-to-frame intervals are tracked against the target period.
+class FramePacer {
+public:
+    struct Stats {
+        float targetMs;            // Period the pacer aims for
+        float averageMs;           // Mean frame-to-frame interval
+        float jitterMs;            // RMS deviation of the interval from the target
+        float maxDeviationMs;
+        unsigned long long frames;
+        unsigned long long missedDeadlines;  // Intervals more than half a period late
+    };
+
+    FramePacer();
+
+    // targetFps 0 follows the display refresh rate
+    void configure(Renderer& renderer, SDL_Window* window, int targetFps);
+
+    void waitForNextFrame();  // Call once per frame, after present
+    void reset();             // Restart pacing, e.g. after the loop slept on its own
+
+    PacingMode getMode() const { return mode; }
+    float getTargetFps() const { return 1e9f / periodNs; }
+    Stats getStats() const;
+    void resetStats();
+
+private:
+    void recordInterval(Uint64 intervalNs);
+
+    PacingMode mode;
+    Uint64 periodNs;
+    Uint64 deadline;       // When the next frame may start, in SLEEP mode
+    Uint64 lastFrameTime;  // 0 until the first frame after a reset
+
+    unsigned long long frames;
+    unsigned long long missedDeadlines;
+    double intervalSumMs;
+    double deviationSquaredSumMs;
+    float maxDeviationMs;
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <string>
+
+enum class FramePhase {
+    EVENTS,   // SDL event polling
+    UPDATE,   // Fixed-timestep simulation ticks
+    RENDER,   // Renderer::render* calls
+    PRESENT,  // Renderer::present (includes the vsync wait)
+    COUNT
+};
+
+struct FrameSample {
+    std::array<float, static_cast<size_t>(FramePhase::COUNT)> phaseMs;
+    float totalMs;
+};
+
+// Per-phase frame timings kept in a fixed-size ring buffer; nothing is
+// allocated once the profiler exists.
+class FrameProfiler {
+public:
+    static constexpr size_t CAPACITY = 240;  // ~4 seconds at 60 FPS
+
+    struct Stats {
+        float p50Ms;
+        float p99Ms;
+        float maxMs;
+        std::array<float, static_cast<size_t>(FramePhase::COUNT)> phaseAverageMs;
+    };
+
+    FrameProfiler();
+
+    void beginFrame();
+    void endPhase(FramePhase phase);  // Charges time since the previous mark to phase
+    void endFrame();
+
+    size_t getSampleCount() const { return count; }
+    // index 0 is the oldest sample still in the buffer
+    const FrameSample& getSample(size_t index) const { return samples[(head + CAPACITY - count + index) % CAPACITY]; }
+    Stats computeStats() const;
+
+    bool dumpCSV(const std::string& path) const;
+
+    static const char* getPhaseName(FramePhase phase);
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    std::array<FrameSample, CAPACITY> samples;
+    size_t head;   // Next slot to write
+    size_t count;
+
+    FrameSample current;
+    Clock::time_point frameStart;
+    Clock::time_point lastMark;
+};
@@ -1,17 +1,24 @@
-#pragma once
+﻿#pragma once
 
 #include <SDL3/SDL.h>
+#include <string>
 #include <vector>
 #include "Knife.hpp"
 #include "Target.hpp"
+#include "Simulation.hpp"
+#include "Replay.hpp"
 #include "Renderer.hpp"
+#include "FrameProfiler.hpp"
+#include "FramePacer.hpp"
+#include "ParticleSystem.hpp"
+#include "AssetArchive.hpp"
 
-enum class GameState {
-    MENU,
-    PLAYING,
-    COLLISION_PAUSE,
-    GAME_OVER,
-    LEVEL_COMPLETE
+struct GameOptions {
+    std::string recordPath;  // Record seed + inputs here on exit
+    std::string replayPath;  // Play a recorded session back instead of reading input
+    int targetFps = 0;       // Frame rate cap; 0 follows the display refresh rate
+    float renderScale = 1.0f;  // Playfield resolution relative to the window, for slow renderers
+    std::string assetPath = "assets.pak";  // Packed assets; loose files under assets/ if missing
 };
 
 class Game {
@@ -19,36 +26,44 @@ public:
     Game();
     ~Game();
 
-    bool initialize();
+    bool initialize(const GameOptions& options = GameOptions());
     void run();
     void cleanup();
 
 private:
     void handleEvents();
-    void update(float deltaTime);
-    void handleInput();
-    void throwKnife();
-    bool checkKnifeCollision();
-    void initializeLevel();
-    void updateStuckKnives();  // NEW: Update positions of stuck knives
+    void handleTap();
+    void interpolateRenderState(float alpha);  // Blend last two ticks for drawing
+    void emitImpactParticles();  // Effects for the impacts of the tick just simulated
+    void render();
+    void finishReplay();
+    bool isIdleState() const;  // Screens that can drop to the idle frame rate
+    void waitForIdleFrame();
 
     SDL_Window* window;
+    AssetArchive assets;  // Mapped for the renderer's lifetime
     Renderer* renderer;
-    GameState currentState;
+    Simulation simulation;
+    bool initialized;  // Set by initialize, cleared by the first cleanup
+    bool running;
 
-    Target target;
-    Knife currentKnife;
-    std::vector<Knife> stuckKnives;  // NEW: Store stuck knives
+    Replay replay;
+    bool recording;
+    bool playback;
+    std::string recordPath;
 
-    int level;
-    int knivesLeft;
-    int score;
-    bool canThrow;
+    Uint64 lastTime;
+    Uint64 accumulator;  // Unsimulated wall-clock time in nanoseconds
+    Uint64 nextIdleFrameTime;  // When the next idle-mode frame is due
+    Uint64 startupTime;  // Just after SDL_Init, for the startup timings in the log
+    bool firstFrameLogged;
 
-    bool collisionDetected;
-    float collisionPauseTimer;
-    static constexpr float COLLISION_PAUSE_DURATION = 2.5f;
+    FramePacer pacer;
+    FrameProfiler profiler;
+    bool showProfiler;  // F3 toggles the overlay, F4 dumps the samples to CSV
 
-    Uint64 lastTime;
-    float gameTime;
+    // Interpolated between the last two ticks, handed to the renderer each frame
+    float renderTargetRotation;
+    float renderKnifeY;
+    ParticleSystem particles;  // Advanced per simulation tick, purely cosmetic
 };
\ No newline at end of file
@@ -6,6 +6,10 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+#ifndef M_SQRT1_2
+#define M_SQRT1_2 0.70710678118654752440
+#endif
+
 namespace GameConstants {
     // Screen dimensions - more reasonable size for desktop
     const int SCREEN_WIDTH = 450;   // Reduced from 720
@@ -16,10 +20,23 @@ namespace GameConstants {
     const int REFERENCE_WIDTH = 450;
     const int REFERENCE_HEIGHT = 800;
 
+    // Simulation timing - gameplay advances in fixed ticks, rendering interpolates between them
+    const int SIMULATION_TICK_RATE = 120;  // Ticks per second
+    const float FIXED_TIMESTEP = 1.0f / SIMULATION_TICK_RATE;
+    const unsigned long long FIXED_TIMESTEP_NS = 1000000000ULL / SIMULATION_TICK_RATE;
+    const unsigned long long MAX_FRAME_TIME_NS = 250000000ULL;  // Clamp long stalls so we don't spiral
+    const int DEFAULT_TARGET_FPS = 60;  // Frame rate when the display doesn't report one
+
+    // Menu and result screens only animate a slow pulse, so they redraw at
+    // this rate and otherwise sleep until input arrives
+    const int IDLE_FRAME_RATE = 30;
+    const unsigned long long IDLE_FRAME_TIME_NS = 1000000000ULL / IDLE_FRAME_RATE;
+
     // Target properties - adjusted for image-based target
     const float TARGET_RADIUS = 140.0f;  // Keep same radius for collision detection
     const float TARGET_X = SCREEN_WIDTH / 2.0f;
     const float TARGET_Y = SCREEN_HEIGHT * 0.3f;  // 30% from top
+    const float BULLSEYE_RADIUS = 22.0f;  // Bullseye sprite drawn over the target center
     const float TARGET_ROTATION_SPEED = 90.0f;  // INCREASED: 3x faster (was 30.0f)
 
     // Knife properties
@@ -39,6 +56,10 @@ namespace GameConstants {
     const int POINTS_PER_KNIFE = 10;
     const int LEVEL_COMPLETE_BONUS = 50;
 
+    // Impact effects
+    const int WOOD_CHIPS_PER_HIT = 16;
+    const int SPARKS_PER_COLLISION = 40;
+
     // UI positioning - properly centered
     const int UI_MARGIN = 30;
     const int UI_LINE_HEIGHT = 35;
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <string>
+#include <vector>
+#include "TtfSupport.hpp"
+
+// Printable ASCII of one font rasterized once, in white, into a single packed
+// surface. Strings are then drawn as textured quads tinted through the vertex
+// color, so changing text (score, stage) never rasterizes or creates textures.
+// The built atlas can be saved as a baked sheet and loaded without FreeType.
+class GlyphAtlas {
+public:
+    static constexpr char FIRST_GLYPH = 32;   // ' '
+    static constexpr char LAST_GLYPH = 126;   // '~'
+    static constexpr int ATLAS_WIDTH = 512;
+
+    struct Glyph {
+        SDL_FRect source;  // Cell in the atlas in pixels, one line tall
+        SDL_FRect uv;      // Same cell in normalized texture coordinates
+        float advance;
+        bool present;
+    };
+
+    GlyphAtlas();
+    ~GlyphAtlas();
+
+    bool build(TTF_Font* font);                 // Rasterize and pack on the CPU; false without TTF support
+    bool saveBaked(const std::string& path) const;  // Metrics, kerning and coverage of a built atlas
+    bool loadBaked(const void* data, size_t size);  // Instead of build(); false if data isn't a valid sheet
+    bool createTexture(SDL_Renderer* renderer); // Upload; the atlas is usable after this
+    void destroyTexture();
+
+    // True if every character of text has a glyph in the atlas
+    bool canRender(const std::string& text) const;
+    float measure(const std::string& text) const;  // Width in pixels, kerning included
+    float getKerning(char previous, char current) const {
+        return kerning[(static_cast<unsigned char>(previous) - FIRST_GLYPH) * GLYPH_COUNT +
+            (static_cast<unsigned char>(current) - FIRST_GLYPH)];
+    }
+
+    const Glyph& getGlyph(char c) const { return glyphs[static_cast<unsigned char>(c) - FIRST_GLYPH]; }
+    int getLineHeight() const { return lineHeight; }
+    size_t getMemoryBytes() const;  // Surface, its texture copy and the kerning table
+    SDL_Texture* getTexture() const { return texture; }
+
+private:
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    static constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+    static constexpr int PADDING = 1;  // Keeps linear filtering from bleeding between cells
+
+    SDL_Surface* surface;
+    SDL_Texture* texture;
+    int lineHeight;
+    int atlasHeight;
+    std::array<Glyph, GLYPH_COUNT> glyphs;
+    std::vector<float> kerning;  // GLYPH_COUNT x GLYPH_COUNT, [previous][current]
+};
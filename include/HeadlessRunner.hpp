@@ -0,0 +1,28 @@
+#pragma once
+
+#include <string>
+#include "Simulation.hpp"
+#include "Replay.hpp"
+
+struct HeadlessOptions {
+    long long ticks = 1000000;   // Fixed-timestep ticks to simulate
+    int throwInterval = 30;      // Ticks between scripted taps
+    bool hasSeed = false;        // Otherwise a random seed is drawn
+    unsigned int seed = 0;
+    std::string recordPath;      // Save the scripted run as a replay
+    std::string replayPath;      // Drive the run from a replay instead of the script
+};
+
+// Steps the Simulation as fast as possible from a scripted tap schedule or
+// a recorded replay, without creating a window or initializing SDL video.
+class HeadlessRunner {
+public:
+    explicit HeadlessRunner(const HeadlessOptions& options);
+
+    int run();
+
+private:
+    HeadlessOptions options;
+    Simulation simulation;
+    Replay replay;
+};
@@ -1,6 +1,5 @@
 #pragma once
 
-#include <SDL3/SDL.h>
 #include "GameConstants.hpp"
 
 class Knife {
@@ -9,7 +8,7 @@ public:
     void update(float deltaTime);
     void reset();
     void stick(float targetX, float targetY, float targetRotation);
-    void updateStuckPosition(float targetX, float targetY, float targetRotation);  // NEW
+    void stickAtAngle(float angle, float targetX, float targetY, float targetRotation);  // angle relative to target
 
     float getX() const { return x; }
     float getY() const { return y; }
@@ -19,6 +18,10 @@ public:
     float getDistanceFromCenter() const { return distanceFromCenter; }
     void setVelocityY(float vel) { velY = vel; }
     void setActive(bool active) { isActive = active; }
+    void setY(float newY) { y = newY; }
+
+    // Position blended between the previous and current simulation tick
+    float getInterpolatedY(float alpha) const { return previousY + (y - previousY) * alpha; }
 
     // NEW: Get rotation for rendering stuck knives
     float getRotation() const { return rotation; }
@@ -30,6 +33,7 @@ public:
 
 private:
     float x, y;
+    float previousY;  // Y at the start of the last tick
     float velY;
     bool isStuck;
     bool isActive;
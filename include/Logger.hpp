@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+// Compile-time log filtering. Calls below KNIFEHIT_LOG_LEVEL compile to
+// nothing and their arguments are never evaluated, but they still count as
+// used and keep their format checked. Set it from CMake with
+// -DKNIFEHIT_LOG_LEVEL=0 to get the debug output back.
+#define KNIFEHIT_LOG_LEVEL_DEBUG 0
+#define KNIFEHIT_LOG_LEVEL_INFO 1
+#define KNIFEHIT_LOG_LEVEL_WARN 2
+#define KNIFEHIT_LOG_LEVEL_ERROR 3
+#define KNIFEHIT_LOG_LEVEL_NONE 4
+
+#ifndef KNIFEHIT_LOG_LEVEL
+#define KNIFEHIT_LOG_LEVEL KNIFEHIT_LOG_LEVEL_INFO
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define KNIFEHIT_PRINTF_FORMAT(fmt, args) __attribute__((format(printf, fmt, args)))
+#else
+#define KNIFEHIT_PRINTF_FORMAT(fmt, args)
+#endif
+
+// Mixed-case names: DEBUG and ERROR are commonly defined as macros
+// (compiler flags, <windows.h>)
+enum class LogLevel {
+    Debug = KNIFEHIT_LOG_LEVEL_DEBUG,
+    Info = KNIFEHIT_LOG_LEVEL_INFO,
+    Warn = KNIFEHIT_LOG_LEVEL_WARN,
+    Error = KNIFEHIT_LOG_LEVEL_ERROR
+};
+
+// printf-style messages are formatted straight into a slot of a fixed-size
+// lock-free ring buffer, so logging never allocates or blocks the caller.
+// A background thread drains the ring to stdout/stderr. If the ring is full
+// the message is dropped and counted.
+class Logger {
+public:
+    static Logger& getInstance() {
+        static Logger instance;
+        return instance;
+    }
+
+    void write(LogLevel level, const char* format, ...) KNIFEHIT_PRINTF_FORMAT(3, 4);
+    static void discard(const char*, ...) KNIFEHIT_PRINTF_FORMAT(1, 2) {}  // What filtered-out calls expand to
+    void flush();  // Drain everything queued so far on the calling thread
+
+    unsigned long long getDroppedCount() const { return dropped.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr size_t CAPACITY = 1024;  // Must be a power of two
+    static constexpr size_t MESSAGE_SIZE = 240;
+
+    struct Record {
+        std::atomic<size_t> sequence;
+        LogLevel level;
+        char message[MESSAGE_SIZE];
+    };
+
+    Logger();
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    size_t drain();
+    void drainLoop();
+
+    std::array<Record, CAPACITY> records;
+    alignas(64) std::atomic<size_t> enqueuePos;
+    alignas(64) size_t dequeuePos;  // Only touched while holding drainMutex
+
+    std::atomic<unsigned long long> dropped;
+    std::atomic<bool> running;
+    std::mutex drainMutex;
+    std::thread drainThread;
+};
+
+// Inside if (false), so nothing is evaluated or emitted
+#define KH_LOG_DISCARD(...) do { if (false) { Logger::discard(__VA_ARGS__); } } while (0)
+
+#if KNIFEHIT_LOG_LEVEL <= KNIFEHIT_LOG_LEVEL_DEBUG
+#define KH_LOG_DEBUG(...) Logger::getInstance().write(LogLevel::Debug, __VA_ARGS__)
+#else
+#define KH_LOG_DEBUG(...) KH_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if KNIFEHIT_LOG_LEVEL <= KNIFEHIT_LOG_LEVEL_INFO
+#define KH_LOG_INFO(...) Logger::getInstance().write(LogLevel::Info, __VA_ARGS__)
+#else
+#define KH_LOG_INFO(...) KH_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if KNIFEHIT_LOG_LEVEL <= KNIFEHIT_LOG_LEVEL_WARN
+#define KH_LOG_WARN(...) Logger::getInstance().write(LogLevel::Warn, __VA_ARGS__)
+#else
+#define KH_LOG_WARN(...) KH_LOG_DISCARD(__VA_ARGS__)
+#endif
+
+#if KNIFEHIT_LOG_LEVEL <= KNIFEHIT_LOG_LEVEL_ERROR
+#define KH_LOG_ERROR(...) Logger::getInstance().write(LogLevel::Error, __VA_ARGS__)
+#else
+#define KH_LOG_ERROR(...) KH_LOG_DISCARD(__VA_ARGS__)
+#endif
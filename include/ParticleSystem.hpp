@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+enum class ParticleKind : uint8_t {
+    WOOD_CHIP,  // Flakes thrown off the rim when a knife sticks
+    SPARK,      // Knife-on-knife collision
+    KNIFE       // The knife bouncing off after a collision
+};
+
+// Cosmetic particles in a fixed-capacity structure-of-arrays pool. Storage is
+// allocated once at construction: emitting into a full pool drops the new
+// particles, and a dead particle is replaced by the last live one, so the
+// live particles are always the first getCount() entries. Has its own RNG and
+// is not part of the simulation state, so it never affects replays.
+class ParticleSystem {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 8192;
+
+    explicit ParticleSystem(size_t capacity = DEFAULT_CAPACITY);
+
+    // Chips spray around (dirX, dirY), the outward normal at the impact
+    void emitWoodChips(float x, float y, float dirX, float dirY, int count);
+    void emitSparks(float x, float y, int count);
+    void emitKnife(float x, float y);  // Knife centered at (x, y), pointing up
+    void update(float deltaTime);
+    void clear() { count = 0; }
+
+    size_t getCount() const { return count; }
+    size_t getCapacity() const { return capacity; }
+
+    ParticleKind getKind(size_t i) const { return kinds[i]; }
+    float getX(size_t i) const { return xs[i]; }
+    float getY(size_t i) const { return ys[i]; }
+    float getVelocityX(size_t i) const { return velocityXs[i]; }
+    float getVelocityY(size_t i) const { return velocityYs[i]; }
+    float getRotation(size_t i) const { return rotations[i]; }  // Degrees
+    float getSize(size_t i) const { return sizes[i]; }
+    uint32_t getColor(size_t i) const { return colors[i]; }   // 0xRRGGBB
+    float getAlpha(size_t i) const { return 1.0f - ages[i] / lifetimes[i]; }
+
+private:
+    void spawn(ParticleKind kind, float x, float y, float velocityX, float velocityY, float gravity,
+        float spin, float lifetime, float size, uint32_t color);
+    float random(float min, float max);
+
+    size_t capacity;
+    size_t count;
+    uint32_t rngState;
+
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<float> velocityXs;
+    std::vector<float> velocityYs;
+    std::vector<float> gravities;
+    std::vector<float> rotations;
+    std::vector<float> spins;      // Degrees per second
+    std::vector<float> ages;
+    std::vector<float> lifetimes;
+    std::vector<float> sizes;
+    std::vector<uint32_t> colors;
+    std::vector<ParticleKind> kinds;
+};
@@ -1,55 +1,134 @@
 #pragma once
 
 #include <SDL3/SDL.h>
-#include <SDL3_ttf/SDL_ttf.h>
 #include <string>
 #include <vector>
 #include "GameConstants.hpp"
 #include "Target.hpp"
 #include "Knife.hpp"
+#include "FrameProfiler.hpp"
+#include "FramePacer.hpp"
+#include "TextCache.hpp"
+#include "GlyphAtlas.hpp"
+#include "SpriteBatch.hpp"
+#include "SpriteAtlas.hpp"
+#include "ParticleSystem.hpp"
+#include "AssetLoader.hpp"
+#include "FontManager.hpp"
 
 class Renderer {
 public:
     Renderer(SDL_Window* window);
+    explicit Renderer(SDL_Surface* targetSurface);  // Offscreen, via the software renderer
     ~Renderer();
 
-    bool initialize();
+    bool initialize(const AssetArchive* assets = nullptr);  // assets must outlive the renderer
+    // initialize() in two steps, so a loading screen can run in between:
+    // begin creates the SDL renderer and queues font and image loading on
+    // loader; finish, once the loader is done, builds the atlases and
+    // textures on this thread. Until then only renderLoadingScreen can draw.
+    bool beginInitialize(AssetLoader& loader, const AssetArchive* assets = nullptr);
+    bool finishInitialize();
+    void renderLoadingScreen(float progress);  // Spinner and progress bar, no assets needed
     void clear();
     void present();
+    bool isVSyncEnabled() const { return vsyncEnabled; }
+    bool setVSync(int interval);  // Present every interval-th refresh; 0 turns vsync off
+    // Re-fit textures to the window's current pixel size, e.g. after a resize
+    // or a move to a display with a different pixel density
+    void handleResize();
+
+    // Draw the playfield (background, target, knives) at this fraction of the
+    // output resolution and upscale it in one blit; HUD text stays native.
+    // Cuts fill rate on software renderers. 1 disables it.
+    void setRenderScale(float scale);
+    float getRenderScale() const { return renderScale; }
+
+    // Copy of the frame drawn so far, in the render target's pixel format;
+    // the caller destroys it. nullptr on failure.
+    SDL_Surface* readPixels();
+    // Pin screen animations to a fixed time so frames are reproducible;
+    // a negative value goes back to the wall clock
+    void setAnimationTime(Sint64 ms) { animationTimeMs = ms; }
 
     // Rendering methods
     void renderBackground();
-    void renderTarget(const Target& target);
-    void renderKnife(const Knife& knife, bool useRotation = false);  // UPDATED: Added rotation param
-    void renderKnives(const std::vector<Knife>& knives);
+    void renderTarget(const Target& target, float rotation);  // rotation overrides the target's own
+    void renderKnife(const Knife& knife, float y, bool useRotation = false);  // y overrides the knife's own
+    // The first count stuck knives as the store placed them, turned a further
+    // rotationDelta degrees about (centerX, centerY)
+    void renderKnives(const StuckKnifeStore& knives, size_t count, float centerX, float centerY, float rotationDelta);
+    void renderParticles(const ParticleSystem& particles);  // Queued into the sprite batch, no extra draw call
     void renderHUD(int level, int score);
     void renderKnifeIndicators(int knivesLeft);  // NEW: Show remaining knives
     void renderMenu();
     void renderGameOver(int score);
     void renderLevelComplete();
-    void renderGame(const Target& target, const std::vector<Knife>& knives,
-        const Knife& currentKnife, int level, int score, int knivesLeft);  // UPDATED: Added knivesLeft
+    // targetRotation and knifeY are the interpolated values to draw with;
+    // the simulation's objects are drawn from, not copied
+    void renderGame(const Target& target, float targetRotation, const Knife& currentKnife, float knifeY,
+        const ParticleSystem& particles, int level, int score, int knivesLeft);
 
     // Text rendering with font support
     void renderText(const std::string& text, int x, int y,
         const SDL_Color& color, bool centered = false,
-        const std::string& fontName = "ui");
+        FontHandle font = FontManager::UI_FONT);
     // Add new method declaration:
-    void renderCollisionPause(const Target& target, const std::vector<Knife>& knives,
-        const Knife& currentKnife, int level, int score, int knivesLeft);
+    void renderCollisionPause(const Target& target, float targetRotation, const Knife& currentKnife,
+        const ParticleSystem& particles, int level, int score, int knivesLeft);
+
+    const TextCache::Stats& getTextCacheStats() const { return textCache.getStats(); }
+
+    // Drop the cached menu/game-over/level-complete layer, e.g. after the
+    // renderer lost its render targets
+    void invalidateStaticLayer();
+
+    // Debug overlay: frame-time graph and percentiles, drawn over the current screen
+    void renderProfilerOverlay(const FrameProfiler& profiler, const FramePacer& pacer);
 
 private:
+    // Screens whose unchanging part is cached in staticLayer
+    enum class StaticLayer {
+        NONE,
+        MENU,
+        GAME_OVER,
+        LEVEL_COMPLETE
+    };
+
     SDL_Window* window;
+    SDL_Surface* targetSurface;
     SDL_Renderer* renderer;
-    SDL_Texture* backgroundTexture;  // Background texture
-    SDL_Texture* targetTexture;      // NEW: Target texture
-    SDL_Texture* knifeTexture;      // NEW: Knife texture
+    SpriteAtlas sprites;             // Background, target, knife and bullseye
+    bool vsyncEnabled;
+    TextCache textCache;         // Text the glyph atlases can't draw
+    std::vector<SDL_Vertex> textVertices;  // Reused by every atlas text draw
+    std::vector<int> textIndices;
+    SpriteBatch spriteBatch;     // Queued atlas sprites, flushed before any other draw
+    SDL_Texture* staticLayer;    // Render target holding the static part of the current screen
+    StaticLayer staticLayerKind;
+    int staticLayerValue;        // Screen-specific content in the layer (the game-over score)
+    Sint64 animationTimeMs;      // Fixed time for the prompt pulse, or -1 for SDL_GetTicks
+    float renderScale;           // Playfield resolution relative to the output
+    SDL_Texture* playfieldTarget;  // Reduced-resolution playfield, created on first use
+    bool playfieldActive;        // Drawing into playfieldTarget right now
+
+    static constexpr float MIN_RENDER_SCALE = 0.25f;
 
     // Helper methods
-    bool loadBackgroundTexture();
-    void cleanupBackgroundTexture();
-    bool loadTargetTexture();        // NEW: Load target texture
-    void cleanupTargetTexture();     // NEW: Cleanup target texture
-    bool loadKnifeTexture();        // NEW: Load knife texture
-    void cleanupKnifeTexture();     // NEW: Cleanup knife texture
+    void flushSprites();
+    float computeOutputScale() const;  // Output pixels per layout unit
+    // Start the frame in the playfield target when renderScale < 1 (or in
+    // the frame itself); endPlayfield upscales it into the frame
+    void beginPlayfield();
+    void endPlayfield();
+    void destroyPlayfieldTarget();
+    Uint8 getPulseAlpha() const;
+    // Clear the frame to the cached static layer, re-rendering it first if
+    // it holds a different screen; false if render targets are unavailable
+    bool drawStaticLayer(StaticLayer layer, int value);
+    void renderMenuStatic();
+    void renderGameOverStatic(int score);
+    void renderLevelCompleteStatic();
+    void renderTextGeometry(const GlyphAtlas& atlas, const std::string& text, int x, int y,
+        const SDL_Color& color, bool centered);
 };
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Simulation.hpp"
+
+enum class InputEventType : uint8_t {
+    TAP = 1
+};
+
+struct InputEvent {
+    unsigned long long tick;  // Simulation tick the input was applied before
+    InputEventType type;
+};
+
+// A recorded session: the level RNG seed plus every input stamped with the
+// simulation tick it landed on. Because the simulation runs on a fixed
+// timestep, feeding the same inputs on the same ticks reproduces the run
+// bit-for-bit.
+class Replay {
+public:
+    Replay();
+
+    // Recording
+    void begin(unsigned int seed);
+    void recordInput(unsigned long long tick, InputEventType type);
+    void finish(const Simulation& simulation);  // Stamps length and final state hash
+
+    // Playback - applies every input due on the simulation's current tick
+    void rewind() { cursor = 0; }
+    void applyInputs(Simulation& simulation);
+    bool isFinished(const Simulation& simulation) const { return simulation.getTickCount() >= totalTicks; }
+    bool verify(const Simulation& simulation) const { return simulation.computeStateHash() == finalStateHash; }
+
+    bool saveToFile(const std::string& path) const;
+    bool loadFromFile(const std::string& path);
+
+    unsigned int getSeed() const { return seed; }
+    unsigned long long getTotalTicks() const { return totalTicks; }
+    size_t getEventCount() const { return events.size(); }
+
+private:
+    unsigned int seed;
+    unsigned long long totalTicks;
+    unsigned long long finalStateHash;
+    std::vector<InputEvent> events;
+    size_t cursor;
+};
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <random>
+#include <vector>
+#include "Knife.hpp"
+#include "Target.hpp"
+
+enum class ImpactType {
+    STICK,      // Knife stuck in the rim
+    COLLISION   // Knife hit a stuck knife
+};
+
+// Where a thrown knife landed, for effects; not part of the gameplay state
+struct Impact {
+    ImpactType type;
+    float x, y;  // On the rim for a stick, among the stuck handles for a collision
+};
+
+enum class GameState {
+    MENU,
+    PLAYING,
+    COLLISION_PAUSE,
+    GAME_OVER,
+    LEVEL_COMPLETE
+};
+
+// Gameplay state and rules with no SDL dependency, so it can be stepped
+// headless as well as driven by the windowed Game.
+class Simulation {
+public:
+    Simulation();
+
+    void reset(unsigned int seed);  // Back to level 1 on the menu, reseeding the level RNG
+    void handleInput();            // A tap/click, interpreted per state
+    void update(float deltaTime);
+
+    GameState getState() const { return currentState; }
+    int getLevel() const { return level; }
+    int getScore() const { return score; }
+    int getKnivesLeft() const { return knivesLeft; }
+    const Target& getTarget() const { return target; }
+    const Knife& getCurrentKnife() const { return currentKnife; }
+    const StuckKnifeStore& getStuckKnives() const { return target.getStuckKnives(); }
+    unsigned int getSeed() const { return seed; }
+    unsigned long long getTickCount() const { return tickCount; }
+    const std::vector<Impact>& getImpacts() const { return impacts; }  // During the last update()
+
+    // Fingerprint of the gameplay state, used to verify replays bit-for-bit
+    unsigned long long computeStateHash() const;
+
+    static unsigned int generateSeed();
+
+    // Hot paths, public so KnifeHitBench can drive them directly
+    bool checkKnifeCollision(float incomingX, float incomingY) const;
+    // Collision for a knife whose relative contact angle moved from startAngle
+    // to endAngle (degrees) while it passed through the handle band
+    bool checkSweptCollision(float startAngle, float endAngle) const;
+    void updateStuckKnives();  // NEW: Update positions of stuck knives
+    void placeStuckKnife(float angle);  // Stick a knife at an angle relative to the target
+
+private:
+    void throwKnife();
+    void initializeLevel();
+    void resolveKnifeSweep();
+    float getIncomingAngle(float targetRotation) const;  // Contact angle relative to the target
+    void stickCurrentKnife(float angle);
+
+    GameState currentState;
+
+    Target target;
+    Knife currentKnife;
+
+    int level;
+    int knivesLeft;
+    int score;
+    bool canThrow;
+
+    bool collisionDetected;
+    float collisionPauseTimer;
+    static constexpr float COLLISION_PAUSE_DURATION = 2.5f;
+
+    float gameTime;
+
+    // Every random gameplay decision draws from this, so a seed plus the
+    // input timeline reproduces a session exactly
+    std::mt19937 rng;
+    unsigned int seed;
+    unsigned long long tickCount;
+
+    std::vector<Impact> impacts;  // Cleared each update, keeps its capacity
+};
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+
+class AssetArchive;
+class AssetLoader;
+
+enum class SpriteId {
+    BACKGROUND,
+    TARGET,
+    KNIFE,
+    BULLSEYE,
+    PARTICLE,  // White dot, tinted per particle
+    COUNT
+};
+
+struct SpriteRegion {
+    SDL_FRect pixels;  // Source rectangle in the atlas texture
+    SDL_FRect uv;      // Same rectangle in normalized texture coordinates
+};
+
+// Every game sprite packed into one texture. Each image is scaled to the
+// size it is drawn at in output pixels, then shelf-packed; the region table
+// is what the renderer draws from, so the whole playfield shares one texture.
+// Decoded images are kept, so a change of output scale repacks without
+// reading the files again.
+class SpriteAtlas {
+public:
+    static constexpr int ATLAS_WIDTH = 1024;  // Minimum; widened if a sprite doesn't fit
+
+    SpriteAtlas();
+    ~SpriteAtlas();
+
+    // Decode every image once, or wrap its pixels in archive without a copy
+    // (the archive must outlive the atlas). Missing images are left to
+    // build(), which draws procedural stand-ins for them.
+    void load(const AssetArchive* archive = nullptr);
+    // Same, one loader job per image; build() only after the loader finished
+    void loadAsync(AssetLoader& loader, const AssetArchive* archive = nullptr);
+    // Scale and pack on the CPU for output pixels per layout unit; false
+    // only if the atlas couldn't be created
+    bool build(float scale = 1.0f);
+    bool createTexture(SDL_Renderer* renderer);
+    void destroyTexture();
+
+    const SpriteRegion& getRegion(SpriteId id) const { return regions[static_cast<size_t>(id)]; }
+    SDL_Texture* getTexture() const { return texture; }
+    float getScale() const { return scale; }
+
+    static const char* getSpriteName(SpriteId id);
+    static const char* getSourcePath(SpriteId id);  // Image file, nullptr for generated sprites
+
+private:
+    SpriteAtlas(const SpriteAtlas&) = delete;
+    SpriteAtlas& operator=(const SpriteAtlas&) = delete;
+
+    static constexpr int PADDING = 2;  // Keeps linear filtering from bleeding between sprites
+
+    static SDL_Surface* decodeImage(SpriteId id, const AssetArchive* archive);
+
+    std::array<SDL_Surface*, static_cast<size_t>(SpriteId::COUNT)> sources;  // Decoded images, nullptr if missing
+    SDL_Surface* surface;
+    SDL_Texture* texture;
+    float scale;
+    std::array<SpriteRegion, static_cast<size_t>(SpriteId::COUNT)> regions;
+};
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Collects rotated textured quads that share one texture and submits them
+// with a single SDL_RenderGeometry call. Vertices are transformed on the CPU,
+// so the cost of a flush doesn't depend on how the renderer handles rotation.
+class SpriteBatch {
+public:
+    SpriteBatch();
+
+    void begin(SDL_Texture* texture);
+
+    // Quad of the given size centered on (centerX, centerY), rotated clockwise
+    // by rotation degrees to match SDL_RenderTextureRotated about the center.
+    // uv is the source region in normalized texture coordinates.
+    void add(float centerX, float centerY, float width, float height, float rotation, const SDL_FRect& uv);
+    // Same, with the rotation already given as its cosine and sine
+    void add(float centerX, float centerY, float width, float height, float cosRotation, float sinRotation,
+        const SDL_FRect& uv);
+    // Same, with the texels multiplied by color
+    void add(float centerX, float centerY, float width, float height, float cosRotation, float sinRotation,
+        const SDL_FRect& uv, const SDL_FColor& color);
+
+    void flush(SDL_Renderer* renderer);  // Draw everything queued so far; the texture stays bound
+
+    size_t getSpriteCount() const { return vertices.size() / 4; }
+
+private:
+    SDL_Texture* texture;
+    std::vector<SDL_Vertex> vertices;  // Capacity is kept between frames
+    std::vector<int> indices;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Every knife stuck in the target, stored as parallel arrays. Each knife's
+// cos/sin is computed once when it sticks; a frame update then needs a single
+// sincos of the target rotation and a few multiply-adds per knife, which the
+// SSE/AVX kernel does four or eight knives at a time.
+class StuckKnifeStore {
+public:
+    // angle is relative to the target, in degrees; position and rotation are
+    // computed immediately for the given target pose
+    void add(float angle, float distance, float targetX, float targetY, float targetRotation);
+    void clear();
+
+    // Recompute every knife's position and sprite rotation for a target pose
+    void update(float targetX, float targetY, float targetRotation);
+    void updateScalar(float targetX, float targetY, float targetRotation);  // Reference kernel, no SIMD
+
+    size_t size() const { return angles.size(); }
+    bool empty() const { return angles.empty(); }
+
+    float getAngle(size_t i) const { return angles[i]; }
+    float getDistance(size_t i) const { return distances[i]; }
+    float getX(size_t i) const { return xs[i]; }
+    float getY(size_t i) const { return ys[i]; }
+    float getRotation(size_t i) const { return rotations[i]; }  // Sprite rotation, degrees
+    // Unit vector from the target center toward the knife, i.e. cos/sin of its current angle
+    float getDirectionX(size_t i) const { return directionXs[i]; }
+    float getDirectionY(size_t i) const { return directionYs[i]; }
+    const std::vector<float>& getAngles() const { return angles; }
+
+private:
+    void updateRange(size_t begin, size_t end, float targetX, float targetY,
+        float cosRotation, float sinRotation, float rotationOffset);
+
+    std::vector<float> angles;
+    std::vector<float> distances;
+    std::vector<float> cosAngles;
+    std::vector<float> sinAngles;
+    std::vector<float> directionXs;
+    std::vector<float> directionYs;
+    std::vector<float> xs;
+    std::vector<float> ys;
+    std::vector<float> rotations;
+};
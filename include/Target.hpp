@@ -1,30 +1,45 @@
 #pragma once
 
+#include <random>
 #include <vector>
 #include "GameConstants.hpp"
+#include "StuckKnifeStore.hpp"
 
 class Target {
 public:
     Target();
     void update(float deltaTime);
-    void reset(int level);
+    void reset(int level, std::mt19937& rng);  // rng is the simulation's seeded level RNG
     void addStuckKnife(float angle, float distance);
+    void updateStuckKnives();  // Move stuck knives to follow the current rotation
 
     // Add this method for setting position
     void setPosition(float newX, float newY) { x = newX; y = newY; }
+    void setRotation(float newRotation) { rotation = newRotation; }
+
+    // Rotation blended between the previous and current simulation tick
+    float getInterpolatedRotation(float alpha) const;
 
     float getX() const { return x; }
     float getY() const { return y; }
     float getRadius() const { return radius; }
     float getRotation() const { return rotation; }
-    const std::vector<float>& getStuckKnifeAngles() const { return stuckKnifeAngles; }
-    const std::vector<float>& getStuckKnifeDistances() const { return stuckKnifeDistances; }
+    const StuckKnifeStore& getStuckKnives() const { return stuckKnives; }
+
+    // Angular occupancy index over every obstacle on the rim (thrown and
+    // pre-stuck knives). True if any obstacle lies strictly within halfWidth
+    // degrees of angle; O(log n) in the obstacle count.
+    bool isArcOccupied(float angle, float halfWidth) const;
+    size_t getObstacleCount() const { return sortedAngles.size(); }
 
 private:
     float x, y;
     float radius;
     float rotation;
+    float previousRotation;  // Rotation at the start of the last tick
     float rotationSpeed;
-    std::vector<float> stuckKnifeAngles;
-    std::vector<float> stuckKnifeDistances;
+    StuckKnifeStore stuckKnives;
+    std::vector<float> sortedAngles;  // Same angles as stuckKnives, ascending in [0, 360)
+
+    bool hasAngleBetween(float low, float high) const;
 };
\ No newline at end of file
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <cstddef>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include "TtfSupport.hpp"
+
+// A rasterized string, owned by the cache
+struct TextTexture {
+    SDL_Texture* texture;
+    int width;
+    int height;
+};
+
+// Least-recently-used cache of rendered text textures, keyed by font, string
+// and RGB. Text is rasterized opaque and alpha is left to the caller
+// (SDL_SetTextureAlphaMod), so fading text reuses one texture. Bounded both
+// by entry count and by texture memory.
+class TextCache {
+public:
+    struct Stats {
+        unsigned long long hits;
+        unsigned long long misses;
+        unsigned long long evictions;
+        size_t entries;
+        size_t bytes;  // Estimated texture memory, 4 bytes per texel
+    };
+
+    static constexpr size_t DEFAULT_MAX_ENTRIES = 128;
+    static constexpr size_t DEFAULT_MAX_BYTES = 8 * 1024 * 1024;
+
+    explicit TextCache(size_t maxEntries = DEFAULT_MAX_ENTRIES, size_t maxBytes = DEFAULT_MAX_BYTES);
+    ~TextCache();
+
+    // Cached texture for the string, rasterizing it on a miss; nullptr on failure
+    // fontId tells fonts apart in the key (a FontHandle); it outlives the
+    // TTF_Font, which may be closed and reopened in between
+    const TextTexture* get(SDL_Renderer* renderer, TTF_Font* font, int fontId,
+        const std::string& text, const SDL_Color& color);
+    void clear();  // Must run before the SDL_Renderer that owns the textures is destroyed
+
+    const Stats& getStats() const { return stats; }
+
+private:
+    struct Entry {
+        std::string key;
+        TextTexture text;
+    };
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    void evict();
+
+    std::list<Entry> entries;  // Front is most recently used
+    std::unordered_map<std::string, std::list<Entry>::iterator> index;
+    std::string scratchKey;  // Reused for lookups so a hit doesn't allocate
+
+    size_t maxEntries;
+    size_t maxBytes;
+    Stats stats;
+};
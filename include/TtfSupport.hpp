@@ -0,0 +1,10 @@
+#pragma once
+
+// SDL3_ttf is optional at runtime. Builds configured with KNIFEHIT_TTF=OFF
+// define KNIFEHIT_NO_TTF and draw text from baked glyph sheets only; the
+// font type stays declared so interfaces don't change between the two.
+#ifdef KNIFEHIT_NO_TTF
+typedef struct TTF_Font TTF_Font;
+#else
+#include <SDL3_ttf/SDL_ttf.h>
+#endif
@@ -0,0 +1,221 @@
+#include "../include/AssetArchive.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <fstream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // File layout (little-endian):
+    //   "KHPK" | version u32 | entry count u32 | entries... | data
+    // Each entry is name length u16 | name | type u8 | pixel format u32 |
+    // width u32 | height u32 | pitch u32 | offset u64 | size u64.
+    // Every data block starts on a 64-byte boundary.
+    const char ARCHIVE_MAGIC[4] = { 'K', 'H', 'P', 'K' };
+    const uint32_t ARCHIVE_VERSION = 1;
+    const size_t DATA_ALIGNMENT = 64;
+
+    void writeUInt(std::vector<uint8_t>& out, unsigned long long value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    bool readUInt(const uint8_t* in, size_t size, size_t& pos, int bytes, unsigned long long& value) {
+        if (pos + bytes > size) return false;
+        value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<unsigned long long>(in[pos++]) << (i * 8);
+        }
+        return true;
+    }
+
+    size_t alignUp(size_t value) {
+        return (value + DATA_ALIGNMENT - 1) / DATA_ALIGNMENT * DATA_ALIGNMENT;
+    }
+}
+
+AssetArchive::AssetArchive()
+    : mapping(nullptr)
+    , mappingSize(0)
+#ifdef _WIN32
+    , fileHandle(nullptr)
+    , mappingHandle(nullptr)
+#else
+    , fileDescriptor(-1)
+#endif
+{
+}
+
+AssetArchive::~AssetArchive() {
+    close();
+}
+
+bool AssetArchive::open(const std::string& path) {
+    close();
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    fileHandle = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        close();
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!view) {
+        KH_LOG_ERROR("Failed to map asset archive %s", path.c_str());
+        close();
+        return false;
+    }
+    mapping = static_cast<const uint8_t*>(view);
+    mappingSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+    fileDescriptor = ::open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) return false;
+
+    struct stat info;
+    if (fstat(fileDescriptor, &info) != 0 || info.st_size == 0) {
+        close();
+        return false;
+    }
+    void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (view == MAP_FAILED) {
+        KH_LOG_ERROR("Failed to map asset archive %s", path.c_str());
+        close();
+        return false;
+    }
+    mapping = static_cast<const uint8_t*>(view);
+    mappingSize = static_cast<size_t>(info.st_size);
+#endif
+
+    if (!parse(path)) {
+        close();
+        return false;
+    }
+    KH_LOG_INFO("Mapped asset archive %s: %zu assets, %zu KB", path.c_str(), entries.size(), mappingSize / 1024);
+    return true;
+}
+
+void AssetArchive::close() {
+    entries.clear();
+#ifdef _WIN32
+    if (mapping) UnmapViewOfFile(mapping);
+    if (mappingHandle) CloseHandle(mappingHandle);
+    if (fileHandle) CloseHandle(fileHandle);
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    if (mapping) munmap(const_cast<uint8_t*>(mapping), mappingSize);
+    if (fileDescriptor >= 0) ::close(fileDescriptor);
+    fileDescriptor = -1;
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+const AssetEntry* AssetArchive::find(const std::string& name) const {
+    auto it = entries.find(name);
+    return it != entries.end() ? &it->second : nullptr;
+}
+
+bool AssetArchive::parse(const std::string& path) {
+    if (mappingSize < 12 || !std::equal(ARCHIVE_MAGIC, ARCHIVE_MAGIC + 4, mapping)) {
+        KH_LOG_ERROR("Not an asset archive: %s", path.c_str());
+        return false;
+    }
+
+    size_t pos = 4;
+    unsigned long long version, count;
+    readUInt(mapping, mappingSize, pos, 4, version);
+    readUInt(mapping, mappingSize, pos, 4, count);
+    if (version != ARCHIVE_VERSION) {
+        KH_LOG_ERROR("Unsupported asset archive version %llu", version);
+        return false;
+    }
+
+    for (unsigned long long i = 0; i < count; i++) {
+        unsigned long long nameLength, type, format, width, height, pitch, offset, size;
+        if (!readUInt(mapping, mappingSize, pos, 2, nameLength) || pos + nameLength > mappingSize) {
+            KH_LOG_ERROR("Truncated asset archive: %s", path.c_str());
+            return false;
+        }
+        std::string name(reinterpret_cast<const char*>(mapping + pos), static_cast<size_t>(nameLength));
+        pos += static_cast<size_t>(nameLength);
+
+        if (!readUInt(mapping, mappingSize, pos, 1, type) || !readUInt(mapping, mappingSize, pos, 4, format) ||
+            !readUInt(mapping, mappingSize, pos, 4, width) || !readUInt(mapping, mappingSize, pos, 4, height) ||
+            !readUInt(mapping, mappingSize, pos, 4, pitch) || !readUInt(mapping, mappingSize, pos, 8, offset) ||
+            !readUInt(mapping, mappingSize, pos, 8, size) || offset > mappingSize || size > mappingSize - offset) {
+            KH_LOG_ERROR("Corrupt entry %s in asset archive %s", name.c_str(), path.c_str());
+            return false;
+        }
+        if (type == static_cast<unsigned long long>(AssetType::IMAGE) && pitch * height > size) {
+            KH_LOG_ERROR("Image %s in asset archive %s is truncated", name.c_str(), path.c_str());
+            return false;
+        }
+
+        AssetEntry entry = { static_cast<AssetType>(type), mapping + offset, static_cast<size_t>(size),
+            static_cast<uint32_t>(format), static_cast<int>(width), static_cast<int>(height), static_cast<int>(pitch) };
+        entries[name] = entry;
+    }
+    return true;
+}
+
+bool AssetArchive::write(const std::string& path, const std::vector<PackedAsset>& assets) {
+    // The table's size fixes where the data starts, so lay it out twice:
+    // once to measure, once with the real offsets
+    std::vector<uint8_t> table;
+    size_t dataStart = 0;
+    for (int pass = 0; pass < 2; pass++) {
+        table.clear();
+        table.insert(table.end(), ARCHIVE_MAGIC, ARCHIVE_MAGIC + 4);
+        writeUInt(table, ARCHIVE_VERSION, 4);
+        writeUInt(table, assets.size(), 4);
+
+        size_t offset = dataStart;
+        for (const PackedAsset& asset : assets) {
+            writeUInt(table, asset.name.size(), 2);
+            table.insert(table.end(), asset.name.begin(), asset.name.end());
+            writeUInt(table, static_cast<uint8_t>(asset.info.type), 1);
+            writeUInt(table, asset.info.pixelFormat, 4);
+            writeUInt(table, static_cast<unsigned int>(asset.info.width), 4);
+            writeUInt(table, static_cast<unsigned int>(asset.info.height), 4);
+            writeUInt(table, static_cast<unsigned int>(asset.info.pitch), 4);
+            writeUInt(table, offset, 8);
+            writeUInt(table, asset.bytes.size(), 8);
+            offset = alignUp(offset + asset.bytes.size());
+        }
+        dataStart = alignUp(table.size());
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        KH_LOG_ERROR("Failed to open asset archive for writing: %s", path.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(table.data()), table.size());
+
+    const char padding[DATA_ALIGNMENT] = {};
+    size_t written = table.size();
+    for (const PackedAsset& asset : assets) {
+        file.write(padding, alignUp(written) - written);
+        written = alignUp(written);
+        file.write(reinterpret_cast<const char*>(asset.bytes.data()), asset.bytes.size());
+        written += asset.bytes.size();
+    }
+    return static_cast<bool>(file);
+}
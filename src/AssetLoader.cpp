@@ -0,0 +1,71 @@
+#include "../include/AssetLoader.hpp"
+#include <algorithm>
+
+AssetLoader::AssetLoader(unsigned int threadCount)
+    : submitted(0)
+    , completed(0)
+    , stopping(false) {
+    if (threadCount == 0) {
+        threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), MAX_THREADS);
+    }
+    for (unsigned int i = 0; i < threadCount; i++) {
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        queue.clear();
+    }
+    jobAvailable.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void AssetLoader::submit(std::function<void()> job) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(std::move(job));
+        submitted++;
+    }
+    jobAvailable.notify_one();
+}
+
+void AssetLoader::wait() {
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [this] { return completed == submitted; });
+}
+
+bool AssetLoader::isFinished() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return completed == submitted;
+}
+
+float AssetLoader::getProgress() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return submitted > 0 ? static_cast<float>(completed) / submitted : 1.0f;
+}
+
+void AssetLoader::workerLoop() {
+    for (;;) {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobAvailable.wait(lock, [this] { return stopping || !queue.empty(); });
+            if (stopping) return;
+            job = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        job();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            completed++;
+        }
+        jobDone.notify_all();
+    }
+}
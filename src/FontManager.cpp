@@ -1,59 +1,381 @@
 #include "../include/FontManager.hpp"
-#include <iostream>
+#include "../include/AssetArchive.hpp"
+#include "../include/AssetLoader.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <mutex>
 
-bool FontManager::initialize() {
-    if (TTF_Init() == -1) {
-        std::cerr << "TTF_Init failed!" << std::endl;
-        return false;
+// Set by CMake to where bake_fonts writes the sheets, or to pre-baked ones
+#ifndef KNIFEHIT_BAKED_FONT_DIR
+#define KNIFEHIT_BAKED_FONT_DIR "fonts"
+#endif
+
+namespace {
+    // Indexed by FontFace; the asset packer ships exactly these files
+    const char* const FACE_PATHS[] = {
+        "assets/fonts/Fredoka-Bold.ttf",
+        "assets/fonts/Rubik-Medium.ttf",
+        "assets/fonts/Rubik-Bold.ttf",
+        "assets/fonts/Rubik-Regular.ttf",
+    };
+    static_assert(sizeof(FACE_PATHS) / sizeof(FACE_PATHS[0]) == static_cast<size_t>(FontFace::COUNT),
+        "one path per font face");
+
+    struct FontStyle {
+        FontHandle handle;
+        FontFace face;
+        int size;
+        bool preload;  // Drawn on the first screens, so worth loading at startup
+    };
+
+    // Built-in styles, in handle order
+    const FontStyle FONT_STYLES[] = {
+        { FontManager::TITLE_FONT, FontFace::FREDOKA_BOLD, 64, true },
+        { FontManager::UI_FONT, FontFace::RUBIK_MEDIUM, 32, true },
+        { FontManager::SCORE_FONT, FontFace::RUBIK_BOLD, 40, true },
+        { FontManager::DEBUG_FONT, FontFace::RUBIK_REGULAR, 14, false },
+    };
+
+    // FreeType faces share one library, which isn't safe to start, stop, or
+    // open and close faces on concurrently; rasterizing from separate faces is.
+    // SDL_ttf is started on first use, so baked fonts never load FreeType.
+    std::mutex ttfMutex;
+    bool ttfStarted = false;  // Guarded by ttfMutex
+
+    void closeTtf(TTF_Font* font) {
+#ifndef KNIFEHIT_NO_TTF
+        if (font) {
+            std::lock_guard<std::mutex> lock(ttfMutex);
+            TTF_CloseFont(font);
+        }
+#else
+        (void)font;
+#endif
     }
 
-    // Load all required fonts with appropriate sizes
-    // Title font - Bold and chunky for KNIFE HIT, GAME OVER, etc.
-    if (!loadFont(TITLE_FONT, "assets/fonts/Fredoka-Bold.ttf", 64)) {
-        std::cerr << "Failed to load title font!" << std::endl;
-        return false;
+    // Packed sheets are stored under their file name
+    bool loadBakedSheet(const std::string& name, const AssetArchive* archive, GlyphAtlas& atlas) {
+        const AssetEntry* packed = archive ? archive->find(name) : nullptr;
+        if (packed && packed->type == AssetType::BAKED_FONT) {
+            return atlas.loadBaked(packed->data, packed->size);
+        }
+
+        std::string path = FontManager::getBakedDirectory() + "/" + name;
+        size_t size = 0;
+        void* data = SDL_LoadFile(path.c_str(), &size);
+        if (!data) return false;
+        bool loaded = atlas.loadBaked(data, size);
+        SDL_free(data);
+        if (!loaded) {
+            KH_LOG_WARN("Ignoring invalid baked font %s", path.c_str());
+        }
+        return loaded;
     }
+}
 
-    // UI font - Medium weight for TAP TO PLAY, STAGE X, etc.
-    if (!loadFont(UI_FONT, "assets/fonts/Rubik-Medium.ttf", 32)) {
-        std::cerr << "Failed to load UI font!" << std::endl;
-        return false;
+FontManager::FontManager()
+    : archive(nullptr)
+    , atlasRenderer(nullptr)
+    , initialized(false)
+    , maxBytes(DEFAULT_MAX_BYTES)
+    , loadedBytes(0)
+    , useClock(0)
+    , evictions(0) {
+    // In handle order, so the built-in constants index the variants
+    for (const FontStyle& style : FONT_STYLES) {
+        getHandle(style.face, style.size);
     }
+}
 
-    // Score font - Bold for numbers
-    if (!loadFont(SCORE_FONT, "assets/fonts/Rubik-Bold.ttf", 40)) {
-        std::cerr << "Failed to load score font!" << std::endl;
-        return false;
+bool FontManager::initialize(const AssetArchive* assets) {
+    archive = assets;
+    initialized = true;
+
+    for (const FontStyle& style : FONT_STYLES) {
+        if (!style.preload) continue;
+        LoadedFont loaded;
+        if (!openFont(style.face, style.size, assets, loaded)) {
+            return false;
+        }
+        install(variants[style.handle], loaded);
     }
+    return true;
+}
+
+bool FontManager::loadAsync(AssetLoader& loader, const AssetArchive* assets) {
+    archive = assets;
+    initialized = true;
 
+    // One job per font: each loads its sheet or opens its font and rasterizes
+    // the glyph atlas, so the font is only ever used from one thread until
+    // it's handed over
+    pendingFonts.clear();
+    for (const FontStyle& style : FONT_STYLES) {
+        if (style.preload) {
+            pendingFonts.push_back({ style.handle, LoadedFont() });
+        }
+    }
+    for (PendingFont& pending : pendingFonts) {
+        const Variant& variant = variants[pending.handle];
+        FontFace face = variant.face;
+        int size = variant.size;
+        LoadedFont* loaded = &pending.loaded;
+        loader.submit([face, size, assets, loaded]() { openFont(face, size, assets, *loaded); });
+    }
     return true;
 }
 
+bool FontManager::finishLoading() {
+    for (PendingFont& pending : pendingFonts) {
+        if (!pending.loaded.atlas) {
+            const Variant& variant = variants[pending.handle];
+            KH_LOG_ERROR("Failed to load %s at %d px!", FACE_PATHS[static_cast<size_t>(variant.face)], variant.size);
+            return false;
+        }
+        install(variants[pending.handle], pending.loaded);
+    }
+    pendingFonts.clear();
+    return true;
+}
+
+std::vector<std::string> FontManager::getFontPaths() {
+    return std::vector<std::string>(std::begin(FACE_PATHS), std::end(FACE_PATHS));
+}
+
+std::string FontManager::getFacePath(FontFace face) {
+    return FACE_PATHS[static_cast<size_t>(face)];
+}
+
+std::string FontManager::getBakedName(FontFace face, int size) {
+    // assets/fonts/Rubik-Bold.ttf at 40 px -> Rubik-Bold-40.khfont
+    std::string name = FACE_PATHS[static_cast<size_t>(face)];
+    name = name.substr(name.find_last_of('/') + 1);
+    name = name.substr(0, name.find_last_of('.'));
+    return name + "-" + std::to_string(size) + ".khfont";
+}
+
+std::string FontManager::getBakedDirectory() {
+    return KNIFEHIT_BAKED_FONT_DIR;
+}
+
+std::vector<std::pair<FontFace, int>> FontManager::getBuiltInStyles() {
+    std::vector<std::pair<FontFace, int>> styles;
+    for (const FontStyle& style : FONT_STYLES) {
+        styles.emplace_back(style.face, style.size);
+    }
+    return styles;
+}
+
 void FontManager::cleanup() {
-    for (auto& pair : fonts) {
-        if (pair.second) {
-            TTF_CloseFont(pair.second);
+    // Fonts loaded but never handed over, e.g. when startup was abandoned
+    for (PendingFont& pending : pendingFonts) {
+        closeTtf(pending.loaded.font);
+    }
+    pendingFonts.clear();
+
+    // Handles stay registered; only what they loaded goes
+    for (Variant& variant : variants) {
+        unload(variant);
+        variant.failed = false;
+        variant.fontFailed = false;
+    }
+    atlasRenderer = nullptr;
+    archive = nullptr;
+    initialized = false;
+
+#ifndef KNIFEHIT_NO_TTF
+    std::lock_guard<std::mutex> lock(ttfMutex);
+    if (ttfStarted) {
+        TTF_Quit();
+        ttfStarted = false;
+    }
+#endif
+}
+
+FontHandle FontManager::getHandle(FontFace face, int size) {
+    for (size_t i = 0; i < variants.size(); i++) {
+        if (variants[i].face == face && variants[i].size == size) {
+            return static_cast<FontHandle>(i);
         }
     }
-    fonts.clear();
-    TTF_Quit();
+    variants.push_back({ face, size, LoadedFont(), 0, 0, false, false });
+    return static_cast<FontHandle>(variants.size() - 1);
 }
 
-bool FontManager::loadFont(const std::string& name, const std::string& path, int size) {
-    TTF_Font* font = TTF_OpenFont(path.c_str(), size);
+bool FontManager::openFont(FontFace face, int size, const AssetArchive* archive, LoadedFont& loaded) {
+    // A baked sheet needs no FreeType for anything the atlas can draw
+    std::unique_ptr<GlyphAtlas> atlas(new GlyphAtlas());
+    if (loadBakedSheet(getBakedName(face, size), archive, *atlas)) {
+        loaded.atlas = std::move(atlas);
+        return true;
+    }
+
+    size_t fontBytes = 0;
+    TTF_Font* font = openTtf(face, size, archive, fontBytes);
     if (!font) {
-        std::cerr << "Failed to load font " << path << std::endl;
         return false;
     }
 
-    fonts[name] = font;
+    // The face is only needed again for text the atlas can't draw, and
+    // getFont reopens it then. Without an atlas, text renders through TTF.
+    if (atlas->build(font)) {
+        loaded.atlas = std::move(atlas);
+        closeTtf(font);
+    }
+    else {
+        KH_LOG_WARN("No glyph atlas for font %s at %d px", FACE_PATHS[static_cast<size_t>(face)], size);
+        loaded.font = font;
+        loaded.fontBytes = fontBytes;
+    }
     return true;
 }
 
-TTF_Font* FontManager::getFont(const std::string& name) {
-    auto it = fonts.find(name);
-    if (it != fonts.end()) {
-        return it->second;
-    }
+TTF_Font* FontManager::openTtf(FontFace face, int size, const AssetArchive* archive, size_t& bytes) {
+    const char* path = FACE_PATHS[static_cast<size_t>(face)];
+#ifdef KNIFEHIT_NO_TTF
+    (void)archive;
+    (void)bytes;
+    KH_LOG_ERROR("No baked sheet for %s at %d px, and TTF support is compiled out", path, size);
     return nullptr;
+#else
+    std::lock_guard<std::mutex> lock(ttfMutex);
+    if (!ttfStarted) {
+        if (!TTF_Init()) {
+            KH_LOG_ERROR("TTF_Init failed!");
+            return nullptr;
+        }
+        ttfStarted = true;
+    }
+
+    // A packed font is opened straight from the mapped archive
+    const AssetEntry* packed = archive ? archive->find(path) : nullptr;
+    TTF_Font* font = nullptr;
+    SDL_PathInfo info = {};
+    if (packed && packed->type == AssetType::FONT) {
+        font = TTF_OpenFontIO(SDL_IOFromConstMem(packed->data, packed->size), true, static_cast<float>(size));
+        bytes = packed->size;
+    }
+    else {
+        font = TTF_OpenFont(path, size);
+        bytes = SDL_GetPathInfo(path, &info) ? static_cast<size_t>(info.size) : 0;
+    }
+    if (!font) {
+        KH_LOG_ERROR("Failed to load font %s", path);
+    }
+    return font;
+#endif
+}
+
+FontManager::Variant* FontManager::use(FontHandle handle) {
+    if (handle < 0 || static_cast<size_t>(handle) >= variants.size()) {
+        return nullptr;
+    }
+    Variant& variant = variants[handle];
+    variant.lastUse = ++useClock;
+    if (variant.loaded.atlas || variant.loaded.font) {
+        return &variant;
+    }
+    if (variant.failed || !initialized) {
+        return nullptr;
+    }
+
+    LoadedFont loaded;
+    if (!openFont(variant.face, variant.size, archive, loaded)) {
+        variant.failed = true;
+        return nullptr;
+    }
+    install(variant, loaded);
+    evict(handle);
+    return &variant;
+}
+
+void FontManager::install(Variant& variant, LoadedFont& loaded) {
+    unload(variant);
+    variant.loaded.font = loaded.font;
+    variant.loaded.fontBytes = loaded.fontBytes;
+    variant.loaded.atlas = std::move(loaded.atlas);
+    loaded.font = nullptr;
+
+    if (variant.loaded.atlas && atlasRenderer) {
+        variant.loaded.atlas->createTexture(atlasRenderer);
+    }
+    variant.bytes = variant.loaded.fontBytes + (variant.loaded.atlas ? variant.loaded.atlas->getMemoryBytes() : 0);
+    loadedBytes += variant.bytes;
+}
+
+void FontManager::unload(Variant& variant) {
+    closeTtf(variant.loaded.font);
+    variant.loaded.font = nullptr;
+    variant.loaded.fontBytes = 0;
+    variant.loaded.atlas.reset();
+    loadedBytes -= variant.bytes;
+    variant.bytes = 0;
+}
+
+void FontManager::evict(FontHandle keep) {
+    // Least recently drawn first; the variant just loaded always stays
+    while (loadedBytes > maxBytes) {
+        Variant* oldest = nullptr;
+        for (size_t i = 0; i < variants.size(); i++) {
+            Variant& variant = variants[i];
+            if (static_cast<FontHandle>(i) == keep || !(variant.loaded.atlas || variant.loaded.font)) continue;
+            if (!oldest || variant.lastUse < oldest->lastUse) {
+                oldest = &variant;
+            }
+        }
+        if (!oldest) break;
+        KH_LOG_DEBUG("Evicting font %s at %d px", FACE_PATHS[static_cast<size_t>(oldest->face)], oldest->size);
+        unload(*oldest);
+        evictions++;
+    }
+}
+
+bool FontManager::isLoaded(FontHandle handle) const {
+    if (handle < 0 || static_cast<size_t>(handle) >= variants.size()) {
+        return false;
+    }
+    const LoadedFont& loaded = variants[handle].loaded;
+    return loaded.atlas || loaded.font;
+}
+
+TTF_Font* FontManager::getFont(FontHandle handle) {
+    Variant* variant = use(handle);
+    if (!variant) return nullptr;
+
+    // Variants from a baked sheet open the TTF only when it's asked for
+    if (!variant->loaded.font && !variant->fontFailed) {
+        size_t fontBytes = 0;
+        variant->loaded.font = openTtf(variant->face, variant->size, archive, fontBytes);
+        variant->fontFailed = !variant->loaded.font;
+        if (variant->loaded.font) {
+            variant->loaded.fontBytes = fontBytes;
+            variant->bytes += fontBytes;
+            loadedBytes += fontBytes;
+            evict(handle);
+        }
+    }
+    return variant->loaded.font;
+}
+
+GlyphAtlas* FontManager::getAtlas(FontHandle handle) {
+    Variant* variant = use(handle);
+    return variant ? variant->loaded.atlas.get() : nullptr;
+}
+
+void FontManager::createAtlasTextures(SDL_Renderer* renderer) {
+    atlasRenderer = renderer;
+    for (Variant& variant : variants) {
+        if (variant.loaded.atlas) {
+            variant.loaded.atlas->createTexture(renderer);
+        }
+    }
+}
+
+void FontManager::destroyAtlasTextures() {
+    atlasRenderer = nullptr;
+    for (Variant& variant : variants) {
+        if (variant.loaded.atlas) {
+            variant.loaded.atlas->destroyTexture();
+        }
+    }
 }
\ No newline at end of file
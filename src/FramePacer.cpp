@@ -0,0 +1,115 @@
+#include "../include/FramePacer.hpp"
+#include "../include/Renderer.hpp"
+#include "../include/GameConstants.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+FramePacer::FramePacer()
+    : mode(PacingMode::SLEEP)
+    , periodNs(1000000000ULL / GameConstants::DEFAULT_TARGET_FPS)
+    , deadline(0)
+    , lastFrameTime(0)
+    , frames(0)
+    , missedDeadlines(0)
+    , intervalSumMs(0.0)
+    , deviationSquaredSumMs(0.0)
+    , maxDeviationMs(0.0f) {
+}
+
+void FramePacer::configure(Renderer& renderer, SDL_Window* window, int targetFps) {
+    float refreshRate = 0.0f;
+    const SDL_DisplayMode* display = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    if (display) {
+        refreshRate = display->refresh_rate;
+    }
+
+    float target = static_cast<float>(targetFps);
+    if (target <= 0.0f) {
+        target = refreshRate > 0.0f ? refreshRate : static_cast<float>(GameConstants::DEFAULT_TARGET_FPS);
+    }
+
+    // Vsync can only pace to the refresh rate or a whole fraction of it
+    mode = PacingMode::SLEEP;
+    if (refreshRate > 0.0f && target <= refreshRate + 0.5f) {
+        int interval = std::max(1, static_cast<int>(std::lround(refreshRate / target)));
+        if (std::fabs(refreshRate / interval - target) < 1.0f && renderer.setVSync(interval)) {
+            mode = PacingMode::VSYNC;
+            target = refreshRate / interval;
+        }
+    }
+    if (mode == PacingMode::SLEEP) {
+        renderer.setVSync(0);
+    }
+
+    periodNs = static_cast<Uint64>(1e9 / target);
+    KH_LOG_INFO("Frame pacing: %.1f FPS via %s (display %.1f Hz)", target,
+        mode == PacingMode::VSYNC ? "vsync" : "sleep", refreshRate);
+    reset();
+    resetStats();
+}
+
+void FramePacer::waitForNextFrame() {
+    if (mode == PacingMode::SLEEP) {
+        Uint64 now = SDL_GetTicksNS();
+        if (now < deadline) {
+            // Sleeps most of the way, then spins the last stretch
+            SDL_DelayPrecise(deadline - now);
+        }
+    }
+
+    Uint64 now = SDL_GetTicksNS();
+    if (lastFrameTime != 0) {
+        recordInterval(now - lastFrameTime);
+    }
+    lastFrameTime = now;
+
+    // Step from the previous deadline so sleep overshoot doesn't accumulate;
+    // after a stall restart from now rather than rushing frames to catch up
+    deadline += periodNs;
+    if (deadline < now) {
+        deadline = now + periodNs;
+    }
+}
+
+void FramePacer::reset() {
+    deadline = 0;
+    lastFrameTime = 0;
+}
+
+FramePacer::Stats FramePacer::getStats() const {
+    Stats stats = {};
+    stats.targetMs = periodNs / 1e6f;
+    stats.frames = frames;
+    stats.missedDeadlines = missedDeadlines;
+    stats.maxDeviationMs = maxDeviationMs;
+    if (frames > 0) {
+        stats.averageMs = static_cast<float>(intervalSumMs / frames);
+        stats.jitterMs = static_cast<float>(std::sqrt(deviationSquaredSumMs / frames));
+    }
+    return stats;
+}
+
+void FramePacer::resetStats() {
+    frames = 0;
+    missedDeadlines = 0;
+    intervalSumMs = 0.0;
+    deviationSquaredSumMs = 0.0;
+    maxDeviationMs = 0.0f;
+}
+
+void FramePacer::recordInterval(Uint64 intervalNs) {
+    double intervalMs = intervalNs / 1e6;
+    double deviationMs = intervalMs - periodNs / 1e6;
+
+    frames++;
+    intervalSumMs += intervalMs;
+    deviationSquaredSumMs += deviationMs * deviationMs;
+    maxDeviationMs = std::max(maxDeviationMs, static_cast<float>(std::fabs(deviationMs)));
+
+    // Half a period late means a refresh was skipped (vsync) or the frame
+    // overran its slot (sleep)
+    if (intervalNs > periodNs + periodNs / 2) {
+        missedDeadlines++;
+    }
+}
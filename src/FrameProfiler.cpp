@@ -0,0 +1,89 @@
+#include "../include/FrameProfiler.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <fstream>
+
+FrameProfiler::FrameProfiler()
+    : samples()
+    , head(0)
+    , count(0)
+    , current() {
+}
+
+void FrameProfiler::beginFrame() {
+    current = FrameSample();
+    frameStart = Clock::now();
+    lastMark = frameStart;
+}
+
+void FrameProfiler::endPhase(FramePhase phase) {
+    Clock::time_point now = Clock::now();
+    current.phaseMs[static_cast<size_t>(phase)] +=
+        std::chrono::duration<float, std::milli>(now - lastMark).count();
+    lastMark = now;
+}
+
+void FrameProfiler::endFrame() {
+    current.totalMs = std::chrono::duration<float, std::milli>(Clock::now() - frameStart).count();
+    samples[head] = current;
+    head = (head + 1) % CAPACITY;
+    if (count < CAPACITY) count++;
+}
+
+FrameProfiler::Stats FrameProfiler::computeStats() const {
+    Stats stats = {};
+    if (count == 0) return stats;
+
+    // Sorting a copy on the stack keeps the ring buffer in arrival order
+    std::array<float, CAPACITY> totals;
+    for (size_t i = 0; i < count; i++) {
+        const FrameSample& sample = getSample(i);
+        totals[i] = sample.totalMs;
+        for (size_t p = 0; p < stats.phaseAverageMs.size(); p++) {
+            stats.phaseAverageMs[p] += sample.phaseMs[p];
+        }
+    }
+    for (float& average : stats.phaseAverageMs) {
+        average /= count;
+    }
+
+    std::sort(totals.begin(), totals.begin() + count);
+    stats.p50Ms = totals[(count - 1) * 50 / 100];
+    stats.p99Ms = totals[(count - 1) * 99 / 100];
+    stats.maxMs = totals[count - 1];
+    return stats;
+}
+
+bool FrameProfiler::dumpCSV(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        KH_LOG_ERROR("Failed to open profiler dump: %s", path.c_str());
+        return false;
+    }
+
+    file << "frame";
+    for (size_t p = 0; p < static_cast<size_t>(FramePhase::COUNT); p++) {
+        file << "," << getPhaseName(static_cast<FramePhase>(p)) << "_ms";
+    }
+    file << ",total_ms\n";
+
+    for (size_t i = 0; i < count; i++) {
+        const FrameSample& sample = getSample(i);
+        file << i;
+        for (float ms : sample.phaseMs) {
+            file << "," << ms;
+        }
+        file << "," << sample.totalMs << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+const char* FrameProfiler::getPhaseName(FramePhase phase) {
+    switch (phase) {
+    case FramePhase::EVENTS: return "events";
+    case FramePhase::UPDATE: return "update";
+    case FramePhase::RENDER: return "render";
+    case FramePhase::PRESENT: return "present";
+    default: return "unknown";
+    }
+}
@@ -1,62 +1,142 @@
 ﻿#include "../include/Game.hpp"
 #include "../include/GameConstants.hpp"
-#include <iostream>
-#include <cmath>
 #include <vector>
 #include "../include/FontManager.hpp"
+#include "../include/Logger.hpp"
 
 Game::Game()
     : window(nullptr)
     , renderer(nullptr)
-    , currentState(GameState::MENU)
-    , level(1)
-    , knivesLeft(GameConstants::KNIVES_PER_LEVEL)
-    , score(0)
-    , canThrow(true)
+    , initialized(false)
+    , running(false)
+    , recording(false)
+    , playback(false)
     , lastTime(0)
-    , gameTime(0)
-    , collisionDetected(false)        // NEW
-    , collisionPauseTimer(0.0f) {     // NEW
+    , accumulator(0)
+    , nextIdleFrameTime(0)
+    , startupTime(0)
+    , firstFrameLogged(false)
+    , showProfiler(false)
+    , renderTargetRotation(0.0f)
+    , renderKnifeY(0.0f) {
 }
 
 Game::~Game() {
     cleanup();
 }
 
-bool Game::initialize() {
+bool Game::initialize(const GameOptions& options) {
+    // Even a failed initialize leaves something for cleanup to release
+    initialized = true;
     if (!SDL_Init(SDL_INIT_VIDEO)) {
-        std::cout << "SDL3 could not initialize! Error: " << SDL_GetError() << std::endl;
+        KH_LOG_ERROR("SDL3 could not initialize! Error: %s", SDL_GetError());
         return false;
     }
+    startupTime = SDL_GetTicksNS();
 
     window = SDL_CreateWindow("Knife Hit",
         GameConstants::SCREEN_WIDTH,
         GameConstants::SCREEN_HEIGHT,
-        SDL_WINDOW_HIGH_PIXEL_DENSITY);
+        SDL_WINDOW_HIGH_PIXEL_DENSITY | SDL_WINDOW_RESIZABLE);
 
     if (!window) {
-        std::cout << "Window could not be created! Error: " << SDL_GetError() << std::endl;
+        KH_LOG_ERROR("Window could not be created! Error: %s", SDL_GetError());
         return false;
     }
 
     // Set window to centered position
     SDL_SetWindowPosition(window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
 
+    // An installed game is usually started from elsewhere, so a bare file
+    // name is also looked for next to the executable
+    if (!assets.open(options.assetPath)) {
+        const char* basePath = SDL_GetBasePath();
+        bool bareName = options.assetPath.find_first_of("/\\:") == std::string::npos;
+        if (!basePath || !bareName || !assets.open(basePath + options.assetPath)) {
+            KH_LOG_INFO("No asset archive at %s, loading loose files", options.assetPath.c_str());
+        }
+    }
+
+    // Fonts and images decode on worker threads while the loading screen
+    // keeps the window responsive
     renderer = new Renderer(window);
-    if (!renderer->initialize()) {
+    AssetLoader loader;
+    if (!renderer->beginInitialize(loader, assets.isOpen() ? &assets : nullptr)) {
         return false;
     }
+    bool loadingFramePresented = false;
+    while (!loader.isFinished()) {
+        SDL_Event event;
+        while (SDL_PollEvent(&event)) {
+            if (event.type == SDL_EVENT_QUIT ||
+                (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_ESCAPE)) {
+                // Not an error: run() returns at once and the loader drops what's left
+                running = false;
+                return true;
+            }
+        }
+        renderer->renderLoadingScreen(loader.getProgress());
+        renderer->present();
+        if (!loadingFramePresented) {
+            KH_LOG_INFO("First loading frame after %.1f ms", (SDL_GetTicksNS() - startupTime) / 1e6);
+            loadingFramePresented = true;
+        }
+        // present() only blocks with vsync; don't spin against the workers without it
+        SDL_Delay(1);
+    }
+    if (!renderer->finishInitialize()) {
+        return false;
+    }
+    KH_LOG_INFO("Assets loaded on %zu threads in %.1f ms", loader.getThreadCount(),
+        (SDL_GetTicksNS() - startupTime) / 1e6);
+    pacer.configure(*renderer, window, options.targetFps);
+    renderer->setRenderScale(options.renderScale);
+
+    unsigned int seed;
+    if (!options.replayPath.empty()) {
+        if (!replay.loadFromFile(options.replayPath)) {
+            return false;
+        }
+        playback = true;
+        seed = replay.getSeed();
+        KH_LOG_INFO("Replaying %s (%zu inputs, %llu ticks)", options.replayPath.c_str(),
+            replay.getEventCount(), replay.getTotalTicks());
+    }
+    else {
+        seed = Simulation::generateSeed();
+        if (!options.recordPath.empty()) {
+            recording = true;
+            recordPath = options.recordPath;
+            replay.begin(seed);
+        }
+    }
 
     lastTime = SDL_GetTicksNS();
-    initializeLevel();
+    accumulator = 0;
+    simulation.reset(seed);
+    running = true;
     return true;
 }
 
 void Game::cleanup() {
+    // main calls this before the destructor does
+    if (!initialized) return;
+    initialized = false;
+
+    finishReplay();
+    FramePacer::Stats pacing = pacer.getStats();
+    if (pacing.frames > 0) {
+        KH_LOG_INFO("Frame pacing: %llu frames, avg %.2f ms (target %.2f), jitter %.2f ms, max off %.2f ms, %llu missed",
+            pacing.frames, pacing.averageMs, pacing.targetMs, pacing.jitterMs, pacing.maxDeviationMs,
+            pacing.missedDeadlines);
+    }
     if (renderer) {
         delete renderer;
         renderer = nullptr;
     }
+    // Fonts may be reading from the archive, so close them before unmapping it
+    FontManager::getInstance().cleanup();
+    assets.close();
     if (window) {
         SDL_DestroyWindow(window);
         window = nullptr;
@@ -70,280 +150,215 @@ void Game::handleEvents() {
         switch (e.type) {
         case SDL_EVENT_QUIT:
             // FIXED: Properly exit the game
-            cleanup();
-            exit(0);
+            running = false;
             break;
 
         case SDL_EVENT_KEY_DOWN:
             if (e.key.key == SDLK_ESCAPE) {
-                cleanup();
-                exit(0);
+                running = false;
+            }
+            else if (e.key.key == SDLK_F3) {
+                showProfiler = !showProfiler;
+            }
+            else if (e.key.key == SDLK_F4) {
+                if (profiler.dumpCSV("frame_profile.csv")) {
+                    KH_LOG_INFO("Wrote %zu frames to frame_profile.csv", profiler.getSampleCount());
+                }
             }
             break;
 
         case SDL_EVENT_MOUSE_BUTTON_DOWN:
             if (e.button.button == SDL_BUTTON_LEFT) {
-                handleInput();
+                handleTap();
             }
             break;
 
         case SDL_EVENT_FINGER_DOWN:
-            handleInput();
+            handleTap();
+            break;
+
+        case SDL_EVENT_WINDOW_PIXEL_SIZE_CHANGED:
+            // Covers resizes and moves to a display with another pixel density
+            renderer->handleResize();
+            break;
+
+        case SDL_EVENT_RENDER_TARGETS_RESET:
+        case SDL_EVENT_RENDER_DEVICE_RESET:
+            // Render target contents are lost; rebuild the cached screen layer
+            renderer->invalidateStaticLayer();
             break;
         }
     }
 }
 
-void Game::handleInput() {
-    switch (currentState) {
-    case GameState::MENU:
-        currentState = GameState::PLAYING;
-        break;
+void Game::handleTap() {
+    // During playback the recording is the only input source
+    if (playback) return;
 
-    case GameState::PLAYING:
-        if (canThrow && knivesLeft > 0 && !currentKnife.isKnifeStuck()) {
-            throwKnife();
-        }
-        break;
+    if (recording) {
+        replay.recordInput(simulation.getTickCount(), InputEventType::TAP);
+    }
+    simulation.handleInput();
+}
 
-    case GameState::GAME_OVER:
-        // Reset game state
-        level = 1;
-        score = 0;
-        stuckKnives.clear();  // Clear stuck knives
-        initializeLevel();
-        currentState = GameState::MENU;
-        break;
+void Game::finishReplay() {
+    if (!recording) return;
+    recording = false;
 
-    case GameState::LEVEL_COMPLETE:
-        level++;
-        score += GameConstants::LEVEL_COMPLETE_BONUS;  // Bonus points
-        stuckKnives.clear();  // FIXED: Clear stuck knives before initializing new level
-        initializeLevel();
-        currentState = GameState::PLAYING;
-        break;
+    replay.finish(simulation);
+    if (replay.saveToFile(recordPath)) {
+        KH_LOG_INFO("Recorded %zu inputs over %llu ticks to %s", replay.getEventCount(),
+            replay.getTotalTicks(), recordPath.c_str());
     }
 }
 
-void Game::update(float deltaTime) {
-
-    // Handle collision pause state
-    if (currentState == GameState::COLLISION_PAUSE) {
-        collisionPauseTimer -= deltaTime;
-        target.update(deltaTime);  // Keep target rotating during pause
-        updateStuckKnives();       // Keep knives rotating with target
+void Game::interpolateRenderState(float alpha) {
+    // Only the values that move between ticks; the renderer draws the
+    // simulation's own objects with them, so nothing is copied per frame
+    renderTargetRotation = simulation.getTarget().getInterpolatedRotation(alpha);
+    renderKnifeY = simulation.getCurrentKnife().getInterpolatedY(alpha);
+}
 
-        if (collisionPauseTimer <= 0) {
-            currentState = GameState::GAME_OVER;
+void Game::emitImpactParticles() {
+    for (const Impact& impact : simulation.getImpacts()) {
+        if (impact.type == ImpactType::STICK) {
+            // Chips fly back off the rim, away from the target center
+            const Target& target = simulation.getTarget();
+            particles.emitWoodChips(impact.x, impact.y, impact.x - target.getX(), impact.y - target.getY(),
+                GameConstants::WOOD_CHIPS_PER_HIT);
+        }
+        else {
+            particles.emitSparks(impact.x, impact.y, GameConstants::SPARKS_PER_COLLISION);
+            particles.emitKnife(impact.x, impact.y + GameConstants::KNIFE_LENGTH / 2);
         }
-        return;  // Don't process other game logic during pause
     }
+}
 
-    if (currentState != GameState::PLAYING) return;
-
-    gameTime += deltaTime;
-    target.update(deltaTime);
-    currentKnife.update(deltaTime);
-
-    // Update stuck knives positions as target rotates
-    updateStuckKnives();
-
-    if (currentKnife.isKnifeActive() && !currentKnife.isKnifeStuck()) {
-        
-        // FIXED: Check if knife tip reaches the edge of target
-        float knifeBottom = currentKnife.getY() + GameConstants::KNIFE_LENGTH / 2;
-        float knifeTop = currentKnife.getY() - GameConstants::KNIFE_IMAGE_TIP_OFFSET;
-        float targetEdge = target.getY() + target.getRadius();
-
-        if (knifeTop >= targetEdge - GameConstants::KNIFE_TARGET_HIT_THRESHOLD &&
-            currentKnife.getY() <= target.getY() + target.getRadius() + 30) {
-
-            // Check collision with stuck knives ONLY when knife reaches target
-            if (checkKnifeCollision()) {
-                // Don't immediately go to game over - pause for visual feedback
-                collisionDetected = true;
-                collisionPauseTimer = COLLISION_PAUSE_DURATION;
-                currentState = GameState::COLLISION_PAUSE;
-
-                // Still stick the knife at collision point for visual feedback
-                float angle = atan2(currentKnife.getY() - target.getY(),
-                    currentKnife.getX() - target.getX()) * 180.0f / M_PI;
-                angle -= target.getRotation();
-                if (angle < 0) angle += 360;
-
-                currentKnife.stick(target.getX(), target.getY(), target.getRotation());
-                target.addStuckKnife(angle, GameConstants::TARGET_RADIUS);
-                stuckKnives.push_back(currentKnife);
-
-                return;
-            }
-
-            // Calculate angle and stick the knife AT THE EDGE
-            float angle = atan2(currentKnife.getY() - target.getY(),
-                currentKnife.getX() - target.getX()) * 180.0f / M_PI;
-            angle -= target.getRotation();
-            if (angle < 0) angle += 360;
+void Game::render() {
+    int level = simulation.getLevel();
+    int score = simulation.getScore();
+    int knivesLeft = simulation.getKnivesLeft();
 
-            // Position knife at the edge of the target
-            currentKnife.stick(target.getX(), target.getY(), target.getRotation());
-            target.addStuckKnife(angle, GameConstants::TARGET_RADIUS);
+    switch (simulation.getState()) {
+    case GameState::MENU:
+        renderer->renderMenu();
+        break;
 
-            // Add to stuck knives collection
-            stuckKnives.push_back(currentKnife);
+    case GameState::PLAYING:
+        // Pass actual stuck knives instead of empty vector
+        renderer->renderGame(simulation.getTarget(), renderTargetRotation, simulation.getCurrentKnife(), renderKnifeY,
+            particles, level, score, knivesLeft);
+        break;
 
-            // Reset for next throw
-            currentKnife = Knife();
-            currentKnife.reset();
-            currentKnife.setActive(true);
+    case GameState::COLLISION_PAUSE:  // NEW: Show collision state
+        renderer->renderCollisionPause(simulation.getTarget(), renderTargetRotation, simulation.getCurrentKnife(),
+            particles, level, score, knivesLeft);
+        break;
 
-            score += GameConstants::POINTS_PER_KNIFE;
-            canThrow = true;
+    case GameState::GAME_OVER:
+        renderer->renderGameOver(score);
+        break;  // Don't exit, wait for input
 
-            if (knivesLeft <= 0) {
-                currentState = GameState::LEVEL_COMPLETE;
-            }
-        }
+    case GameState::LEVEL_COMPLETE:
+        renderer->renderLevelComplete();
+        // FIXED: Don't auto-advance, wait for user input only
+        break;
     }
 }
 
-bool Game::checkKnifeCollision() {
-    if (stuckKnives.empty()) {
-        std::cout << "No stuck knives to check collision against" << std::endl;
-        return false;
-    }
-
-    std::cout << "\n=== COLLISION CHECK START ===" << std::endl;
-    std::cout << "Number of stuck knives: " << stuckKnives.size() << std::endl;
-    std::cout << "Collision threshold: " << GameConstants::SPATIAL_COLLISION_THRESHOLD << "px" << std::endl;
-
-    // Get current knife position and target info
-    float incomingX = currentKnife.getX();
-    float incomingY = currentKnife.getY();
-    float targetX = target.getX();
-    float targetY = target.getY();
-    float targetRotation = target.getRotation();
+void Game::run() {
+    while (running) {
+        bool idle = isIdleState();
+        if (idle) {
+            waitForIdleFrame();
+        }
 
-    std::cout << "Incoming knife pos: (" << incomingX << ", " << incomingY << ")" << std::endl;
-    std::cout << "Target pos: (" << targetX << ", " << targetY << "), rotation: " << targetRotation << "°" << std::endl;
+        profiler.beginFrame();
 
-    // Calculate incoming knife's angle relative to target
-    float incomingAngle = atan2(incomingY - targetY, incomingX - targetX) * 180.0f / M_PI;
-    float originalAngle = incomingAngle;
+        handleEvents();
+        profiler.endPhase(FramePhase::EVENTS);
 
-    // Normalize the angle relative to target's current rotation
-    incomingAngle -= targetRotation;
-    if (incomingAngle < 0) incomingAngle += 360;
-    if (incomingAngle >= 360) incomingAngle -= 360;
+        Uint64 currentTime = SDL_GetTicksNS();
+        Uint64 frameTime = currentTime - lastTime;
+        lastTime = currentTime;
 
-    std::cout << "Incoming knife angle: " << originalAngle << "° (absolute) -> " << incomingAngle << "° (relative)" << std::endl;
+        // A long stall (window drag, debugger) would otherwise queue up hundreds of ticks
+        if (frameTime > GameConstants::MAX_FRAME_TIME_NS) {
+            frameTime = GameConstants::MAX_FRAME_TIME_NS;
+        }
+        accumulator += frameTime;
 
-    // Check against each stuck knife
-    for (size_t i = 0; i < stuckKnives.size(); i++) {
-        const auto& stuckKnife = stuckKnives[i];
-        float stuckAngle = stuckKnife.getStuckAngle();
+        // Advance the simulation in fixed steps so speeds don't depend on frame rate
+        while (accumulator >= GameConstants::FIXED_TIMESTEP_NS) {
+            if (playback) {
+                replay.applyInputs(simulation);
+            }
+            simulation.update(GameConstants::FIXED_TIMESTEP);
+            accumulator -= GameConstants::FIXED_TIMESTEP_NS;
+            // Particles step with the ticks, so their motion doesn't depend on frame rate
+            emitImpactParticles();
+            particles.update(GameConstants::FIXED_TIMESTEP);
+
+            if (playback && replay.isFinished(simulation)) {
+                if (replay.verify(simulation)) {
+                    KH_LOG_INFO("Replay finished: final state matches the recording");
+                }
+                else {
+                    KH_LOG_ERROR("Replay DIVERGED: final state does not match the recording");
+                }
+                running = false;
+                break;
+            }
+        }
 
-        std::cout << "\nChecking against stuck knife " << i << ":" << std::endl;
-        std::cout << "  Stuck angle: " << stuckAngle << "°" << std::endl;
+        profiler.endPhase(FramePhase::UPDATE);
 
-        // Calculate angular difference
-        float angleDiff = std::abs(incomingAngle - stuckAngle);
-        if (angleDiff > 180) {
-            angleDiff = 360 - angleDiff;
+        float alpha = static_cast<float>(accumulator) / GameConstants::FIXED_TIMESTEP_NS;
+        interpolateRenderState(alpha);
+        render();
+        if (showProfiler) {
+            renderer->renderProfilerOverlay(profiler, pacer);
         }
+        profiler.endPhase(FramePhase::RENDER);
 
-        std::cout << "  Angular difference: " << angleDiff << "°" << std::endl;
+        renderer->present();
+        profiler.endPhase(FramePhase::PRESENT);
+        profiler.endFrame();
 
-        // Convert angular difference to physical distance at handle position
-        float handleRadius = GameConstants::TARGET_RADIUS + GameConstants::KNIFE_IMAGE_HANDLE_OFFSET;
-        float physicalSeparation = (angleDiff * M_PI / 180.0f) * handleRadius;
-
-        std::cout << "  Handle radius: " << handleRadius << "px" << std::endl;
-        std::cout << "  Physical separation: " << physicalSeparation << "px" << std::endl;
-        std::cout << "  Collision threshold: " << GameConstants::SPATIAL_COLLISION_THRESHOLD << "px" << std::endl;
+        if (!firstFrameLogged) {
+            KH_LOG_INFO("Time to first game frame: %.1f ms", (SDL_GetTicksNS() - startupTime) / 1e6);
+            firstFrameLogged = true;
+        }
 
-        // Check if handles would overlap/collide
-        if (physicalSeparation < GameConstants::SPATIAL_COLLISION_THRESHOLD) {
-            std::cout << "  🔴 COLLISION! " << physicalSeparation << " < " << GameConstants::SPATIAL_COLLISION_THRESHOLD << std::endl;
-            std::cout << "=== COLLISION CHECK END (COLLISION FOUND) ===" << std::endl;
-            return true;
+        // Idle screens wait on input instead; their frames stay out of the pacing stats
+        if (idle) {
+            nextIdleFrameTime = SDL_GetTicksNS() + GameConstants::IDLE_FRAME_TIME_NS;
+            pacer.reset();
         }
         else {
-            std::cout << "  ✅ No collision with this knife" << std::endl;
+            pacer.waitForNextFrame();
         }
     }
-
-    std::cout << "✅ No collisions detected with any stuck knife" << std::endl;
-    std::cout << "=== COLLISION CHECK END (NO COLLISION) ===" << std::endl;
-    return false;
 }
 
-void Game::updateStuckKnives() {
-    // Update all stuck knives to rotate with the target
-    for (auto& knife : stuckKnives) {
-        knife.updateStuckPosition(target.getX(), target.getY(), target.getRotation());
+bool Game::isIdleState() const {
+    // Nothing moves on these screens except the prompt pulse
+    switch (simulation.getState()) {
+    case GameState::MENU:
+    case GameState::GAME_OVER:
+    case GameState::LEVEL_COMPLETE:
+        return true;
+    default:
+        return false;
     }
 }
 
-void Game::throwKnife() {
-    if (!canThrow || knivesLeft <= 0) return;  // Safety check
-
-    currentKnife.setVelocityY(-GameConstants::KNIFE_SPEED);
-    currentKnife.setActive(true);
-    canThrow = false;
-    knivesLeft--;
-}
-
-void Game::initializeLevel() {
-    target.reset(level);
-    currentKnife = Knife(); // Reset knife to starting position
-    stuckKnives.clear();  // Clear stuck knives for new level
-    knivesLeft = GameConstants::KNIVES_PER_LEVEL;
-    canThrow = true;
-
-    // NEW: Reset collision state
-    collisionDetected = false;
-    collisionPauseTimer = 0.0f;
-
-    // FIXED: Ensure knife is properly positioned and visible
-    currentKnife.reset(); // Make sure knife is at starting position
-    currentKnife.setActive(true); // Make sure knife is active and visible
-}
-
-void Game::run() {
-    while (true) {  // FIXED: Use infinite loop with proper exit handling
-        handleEvents();
-
-        Uint64 currentTime = SDL_GetTicksNS();
-        float deltaTime = (currentTime - lastTime) / 1e9f;
-        lastTime = currentTime;
+void Game::waitForIdleFrame() {
+    // Sleep until the next pulse frame is due or input arrives, whichever is
+    // first. Passing no event leaves it queued for handleEvents.
+    Uint64 now = SDL_GetTicksNS();
+    if (now >= nextIdleFrameTime) return;
 
-        update(deltaTime);
-
-        switch (currentState) {
-        case GameState::MENU:
-            renderer->renderMenu();
-            break;
-
-        case GameState::PLAYING:
-            // Pass actual stuck knives instead of empty vector
-            renderer->renderGame(target, stuckKnives, currentKnife, level, score, knivesLeft);
-            break;
-
-        case GameState::COLLISION_PAUSE:  // NEW: Show collision state
-            renderer->renderCollisionPause(target, stuckKnives, currentKnife, level, score, knivesLeft);
-            break;
-
-        case GameState::GAME_OVER:
-            renderer->renderGameOver(score);
-            break;  // Don't exit, wait for input
-
-        case GameState::LEVEL_COMPLETE:
-            renderer->renderLevelComplete();
-            // FIXED: Don't auto-advance, wait for user input only
-            break;
-        }
-
-        // Small delay to prevent excessive CPU usage
-        SDL_Delay(16);  // ~60 FPS
-    }
+    Uint64 remainingMs = (nextIdleFrameTime - now + SDL_NS_PER_MS - 1) / SDL_NS_PER_MS;
+    SDL_WaitEventTimeout(nullptr, static_cast<Sint32>(remainingMs));
 }
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "../include/GlyphAtlas.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+    // Baked sheet layout (little-endian):
+    //   "KHBF" | version u32 | glyph count u32 | line height u32 | width u32 | height u32 |
+    //   per glyph: present u8 | x, y, w, h u16 | advance i16 |
+    //   kerning i16 per pair, [previous][current] | coverage, one byte per texel
+    // The atlas is white, so alpha is all that needs storing.
+    const char BAKED_MAGIC[4] = { 'K', 'H', 'B', 'F' };
+    const uint32_t BAKED_VERSION = 1;
+
+    void writeUInt(std::vector<uint8_t>& out, uint32_t value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    bool readUInt(const uint8_t* in, size_t size, size_t& pos, int bytes, uint32_t& value) {
+        if (pos + bytes > size) return false;
+        value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<uint32_t>(in[pos++]) << (i * 8);
+        }
+        return true;
+    }
+}
+
+GlyphAtlas::GlyphAtlas()
+    : surface(nullptr)
+    , texture(nullptr)
+    , lineHeight(0)
+    , atlasHeight(0)
+    , glyphs() {
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    destroyTexture();
+    if (surface) {
+        SDL_DestroySurface(surface);
+    }
+}
+
+bool GlyphAtlas::build(TTF_Font* font) {
+#ifdef KNIFEHIT_NO_TTF
+    (void)font;
+    return false;
+#else
+    lineHeight = TTF_GetFontHeight(font);
+    const SDL_Color white = { 255, 255, 255, 255 };
+
+    // Rasterize every glyph first; each comes back one line tall, so the
+    // cells pack into fixed-height shelves
+    std::array<SDL_Surface*, GLYPH_COUNT> cells = {};
+    int penX = PADDING;
+    int penY = PADDING;
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        Uint32 codepoint = static_cast<Uint32>(FIRST_GLYPH + i);
+        Glyph& glyph = glyphs[i];
+        glyph = Glyph();
+
+        int advance = 0;
+        if (!TTF_FontHasGlyph(font, codepoint) ||
+            !TTF_GetGlyphMetrics(font, codepoint, nullptr, nullptr, nullptr, nullptr, &advance)) {
+            continue;
+        }
+        glyph.advance = static_cast<float>(advance);
+        glyph.present = true;
+
+        cells[i] = TTF_RenderGlyph_Blended(font, codepoint, white);
+        if (!cells[i]) continue;  // Whitespace has an advance but no pixels
+
+        int w = cells[i]->w;
+        if (penX + w + PADDING > ATLAS_WIDTH) {
+            penX = PADDING;
+            penY += lineHeight + PADDING;
+        }
+        glyph.source = { static_cast<float>(penX), static_cast<float>(penY),
+            static_cast<float>(w), static_cast<float>(cells[i]->h) };
+        penX += w + PADDING;
+    }
+    atlasHeight = penY + lineHeight + PADDING;
+
+    if (surface) SDL_DestroySurface(surface);
+    surface = SDL_CreateSurface(ATLAS_WIDTH, atlasHeight, SDL_PIXELFORMAT_ARGB8888);
+    if (surface) {
+        SDL_FillSurfaceRect(surface, nullptr, 0);  // Fully transparent
+    }
+
+    for (int i = 0; i < GLYPH_COUNT; i++) {
+        if (!cells[i]) continue;
+        if (surface) {
+            // Copy the coverage as-is rather than blending it onto transparent black
+            SDL_SetSurfaceBlendMode(cells[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dest = { static_cast<int>(glyphs[i].source.x), static_cast<int>(glyphs[i].source.y),
+                cells[i]->w, cells[i]->h };
+            SDL_BlitSurface(cells[i], nullptr, surface, &dest);
+        }
+        SDL_DestroySurface(cells[i]);
+
+        const SDL_FRect& source = glyphs[i].source;
+        glyphs[i].uv = { source.x / ATLAS_WIDTH, source.y / atlasHeight,
+            source.w / ATLAS_WIDTH, source.h / atlasHeight };
+    }
+    if (!surface) {
+        KH_LOG_ERROR("Failed to create glyph atlas surface: %s", SDL_GetError());
+        return false;
+    }
+
+    // Kerning is looked up per character pair while drawing, so tabulate it now
+    kerning.assign(GLYPH_COUNT * GLYPH_COUNT, 0.0f);
+    for (int a = 0; a < GLYPH_COUNT; a++) {
+        if (!glyphs[a].present) continue;
+        for (int b = 0; b < GLYPH_COUNT; b++) {
+            int amount = 0;
+            if (glyphs[b].present && TTF_GetGlyphKerning(font, FIRST_GLYPH + a, FIRST_GLYPH + b, &amount)) {
+                kerning[a * GLYPH_COUNT + b] = static_cast<float>(amount);
+            }
+        }
+    }
+    return true;
+#endif
+}
+
+bool GlyphAtlas::saveBaked(const std::string& path) const {
+    if (!surface) return false;
+
+    std::vector<uint8_t> out(BAKED_MAGIC, BAKED_MAGIC + sizeof(BAKED_MAGIC));
+    writeUInt(out, BAKED_VERSION, 4);
+    writeUInt(out, GLYPH_COUNT, 4);
+    writeUInt(out, static_cast<uint32_t>(lineHeight), 4);
+    writeUInt(out, ATLAS_WIDTH, 4);
+    writeUInt(out, static_cast<uint32_t>(atlasHeight), 4);
+    for (const Glyph& glyph : glyphs) {
+        writeUInt(out, glyph.present ? 1 : 0, 1);
+        writeUInt(out, static_cast<uint32_t>(glyph.source.x), 2);
+        writeUInt(out, static_cast<uint32_t>(glyph.source.y), 2);
+        writeUInt(out, static_cast<uint32_t>(glyph.source.w), 2);
+        writeUInt(out, static_cast<uint32_t>(glyph.source.h), 2);
+        writeUInt(out, static_cast<uint16_t>(static_cast<int16_t>(glyph.advance)), 2);
+    }
+    for (float amount : kerning) {
+        writeUInt(out, static_cast<uint16_t>(static_cast<int16_t>(amount)), 2);
+    }
+
+    // Surface rows are ARGB8888; keep the alpha byte of each texel
+    for (int y = 0; y < surface->h; y++) {
+        const Uint32* row = reinterpret_cast<const Uint32*>(static_cast<const Uint8*>(surface->pixels) + y * surface->pitch);
+        for (int x = 0; x < surface->w; x++) {
+            out.push_back(static_cast<uint8_t>(row[x] >> 24));
+        }
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+    if (!file) {
+        KH_LOG_ERROR("Failed to write baked font %s", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool GlyphAtlas::loadBaked(const void* data, size_t size) {
+    const uint8_t* in = static_cast<const uint8_t*>(data);
+    size_t pos = sizeof(BAKED_MAGIC);
+    uint32_t version = 0, glyphCount = 0, fontHeight = 0, width = 0, rows = 0;
+    if (size < pos || memcmp(in, BAKED_MAGIC, sizeof(BAKED_MAGIC)) != 0 ||
+        !readUInt(in, size, pos, 4, version) || version != BAKED_VERSION ||
+        !readUInt(in, size, pos, 4, glyphCount) || glyphCount != GLYPH_COUNT ||
+        !readUInt(in, size, pos, 4, fontHeight) || !readUInt(in, size, pos, 4, width) || width != ATLAS_WIDTH ||
+        !readUInt(in, size, pos, 4, rows) || rows == 0 || rows > 16384) {
+        return false;
+    }
+
+    std::array<Glyph, GLYPH_COUNT> loaded = {};
+    for (Glyph& glyph : loaded) {
+        uint32_t present = 0, x = 0, y = 0, w = 0, h = 0, advance = 0;
+        if (!readUInt(in, size, pos, 1, present) || !readUInt(in, size, pos, 2, x) || !readUInt(in, size, pos, 2, y) ||
+            !readUInt(in, size, pos, 2, w) || !readUInt(in, size, pos, 2, h) || !readUInt(in, size, pos, 2, advance) ||
+            x + w > width || y + h > rows) {
+            return false;
+        }
+        glyph.present = present != 0;
+        glyph.advance = static_cast<float>(static_cast<int16_t>(advance));
+        glyph.source = { static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h) };
+        glyph.uv = { glyph.source.x / width, glyph.source.y / rows, glyph.source.w / width, glyph.source.h / rows };
+    }
+
+    std::vector<float> loadedKerning(GLYPH_COUNT * GLYPH_COUNT);
+    for (float& amount : loadedKerning) {
+        uint32_t value = 0;
+        if (!readUInt(in, size, pos, 2, value)) return false;
+        amount = static_cast<float>(static_cast<int16_t>(value));
+    }
+    if (size - pos < static_cast<size_t>(width) * rows) {
+        return false;
+    }
+
+    SDL_Surface* expanded = SDL_CreateSurface(static_cast<int>(width), static_cast<int>(rows), SDL_PIXELFORMAT_ARGB8888);
+    if (!expanded) {
+        KH_LOG_ERROR("Failed to create glyph atlas surface: %s", SDL_GetError());
+        return false;
+    }
+    for (uint32_t y = 0; y < rows; y++) {
+        Uint32* row = reinterpret_cast<Uint32*>(static_cast<Uint8*>(expanded->pixels) + y * expanded->pitch);
+        for (uint32_t x = 0; x < width; x++) {
+            row[x] = (static_cast<Uint32>(in[pos++]) << 24) | 0x00FFFFFF;
+        }
+    }
+
+    destroyTexture();
+    if (surface) SDL_DestroySurface(surface);
+    surface = expanded;
+    lineHeight = static_cast<int>(fontHeight);
+    atlasHeight = static_cast<int>(rows);
+    glyphs = loaded;
+    kerning.swap(loadedKerning);
+    return true;
+}
+
+bool GlyphAtlas::createTexture(SDL_Renderer* renderer) {
+    destroyTexture();
+    if (!surface) return false;
+
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        KH_LOG_ERROR("Failed to create glyph atlas texture: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void GlyphAtlas::destroyTexture() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+size_t GlyphAtlas::getMemoryBytes() const {
+    // Counted with the texture even before it's created, so the figure
+    // doesn't change under a cache that budgets by it
+    size_t pixels = surface ? static_cast<size_t>(surface->w) * surface->h * 4 : 0;
+    return pixels * 2 + kerning.size() * sizeof(float);
+}
+
+bool GlyphAtlas::canRender(const std::string& text) const {
+    return std::all_of(text.begin(), text.end(), [this](char c) {
+        return c >= FIRST_GLYPH && c <= LAST_GLYPH && getGlyph(c).present;
+    });
+}
+
+float GlyphAtlas::measure(const std::string& text) const {
+    float width = 0.0f;
+    for (size_t i = 0; i < text.size(); i++) {
+        if (i > 0) width += getKerning(text[i - 1], text[i]);
+        width += getGlyph(text[i]).advance;
+    }
+    return width;
+}
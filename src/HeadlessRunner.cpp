@@ -0,0 +1,100 @@
+#include "../include/HeadlessRunner.hpp"
+#include "../include/GameConstants.hpp"
+#include "../include/Logger.hpp"
+#include <chrono>
+#include <iostream>
+
+HeadlessRunner::HeadlessRunner(const HeadlessOptions& options)
+    : options(options) {
+}
+
+int HeadlessRunner::run() {
+    bool playback = !options.replayPath.empty();
+    bool recording = !playback && !options.recordPath.empty();
+
+    if (playback) {
+        if (!replay.loadFromFile(options.replayPath)) {
+            return 1;
+        }
+        options.ticks = static_cast<long long>(replay.getTotalTicks());
+        simulation.reset(replay.getSeed());
+        std::cout << "Replaying " << options.replayPath << ": seed " << replay.getSeed()
+            << ", " << replay.getEventCount() << " inputs" << std::endl;
+    }
+    else {
+        if (options.ticks <= 0 || options.throwInterval <= 0) {
+            KH_LOG_ERROR("Headless run needs positive --ticks and --throw-interval");
+            return 1;
+        }
+        simulation.reset(options.hasSeed ? options.seed : Simulation::generateSeed());
+        if (recording) {
+            replay.begin(simulation.getSeed());
+        }
+    }
+
+    long long taps = 0;
+    long long levelsCompleted = 0;
+    long long gamesOver = 0;
+    int bestScore = 0;
+    GameState lastState = simulation.getState();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (long long tick = 0; tick < options.ticks; tick++) {
+        if (playback) {
+            replay.applyInputs(simulation);
+        }
+        // Scripted input: tap on a fixed cadence; menus and end screens
+        // advance on the same tap
+        else if (tick % options.throwInterval == 0) {
+            if (recording) {
+                replay.recordInput(simulation.getTickCount(), InputEventType::TAP);
+            }
+            simulation.handleInput();
+            taps++;
+        }
+
+        simulation.update(GameConstants::FIXED_TIMESTEP);
+
+        GameState state = simulation.getState();
+        if (state != lastState) {
+            if (state == GameState::LEVEL_COMPLETE) levelsCompleted++;
+            if (state == GameState::GAME_OVER) gamesOver++;
+            lastState = state;
+        }
+        if (simulation.getScore() > bestScore) {
+            bestScore = simulation.getScore();
+        }
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+    double ticksPerSecond = seconds > 0 ? options.ticks / seconds : 0;
+    double simulatedSeconds = options.ticks * static_cast<double>(GameConstants::FIXED_TIMESTEP);
+
+    std::cout << "Headless run: " << options.ticks << " ticks (" << simulatedSeconds
+        << " s simulated) in " << seconds << " s" << std::endl;
+    std::cout << "  Ticks per second: " << static_cast<long long>(ticksPerSecond)
+        << " (" << ticksPerSecond / GameConstants::SIMULATION_TICK_RATE << "x real time)" << std::endl;
+    std::cout << "  Taps: " << (playback ? static_cast<long long>(replay.getEventCount()) : taps)
+        << ", levels completed: " << levelsCompleted
+        << ", games over: " << gamesOver << ", best score: " << bestScore << std::endl;
+
+    if (recording) {
+        replay.finish(simulation);
+        if (!replay.saveToFile(options.recordPath)) {
+            return 1;
+        }
+        std::cout << "  Recorded replay to " << options.recordPath << std::endl;
+    }
+
+    if (playback) {
+        if (!replay.verify(simulation)) {
+            KH_LOG_ERROR("Replay DIVERGED: final state does not match the recording");
+            return 2;
+        }
+        std::cout << "  Replay verified: final state matches the recording" << std::endl;
+    }
+
+    return 0;
+}
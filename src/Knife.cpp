@@ -4,6 +4,7 @@
 Knife::Knife()
     : x(GameConstants::TARGET_X)
     , y(GameConstants::KNIFE_START_Y)
+    , previousY(GameConstants::KNIFE_START_Y)
     , velY(0)
     , isStuck(false)
     , isActive(true)
@@ -13,6 +14,7 @@ Knife::Knife()
 }
 
 void Knife::update(float deltaTime) {
+    previousY = y;
     if (isActive && !isStuck) {
         y += velY * deltaTime;
     }
@@ -21,6 +23,7 @@ void Knife::update(float deltaTime) {
 void Knife::reset() {
     x = GameConstants::TARGET_X;
     y = GameConstants::KNIFE_START_Y;
+    previousY = y;
     velY = 0;
     isStuck = false;
     isActive = true;
@@ -30,14 +33,18 @@ void Knife::reset() {
 }
 
 void Knife::stick(float targetX, float targetY, float targetRotation) {
-    isStuck = true;
-    velY = 0;
-
     // Calculate angle relative to target center  
     float angle = atan2(y - targetY, x - targetX) * 180.0f / M_PI;
     angle -= targetRotation; // Make relative to target rotation
     if (angle < 0) angle += 360;
 
+    stickAtAngle(angle, targetX, targetY, targetRotation);
+}
+
+void Knife::stickAtAngle(float angle, float targetX, float targetY, float targetRotation) {
+    isStuck = true;
+    velY = 0;
+
     stuckAngle = angle;
     distanceFromCenter = GameConstants::TARGET_RADIUS;
 
@@ -46,27 +53,12 @@ void Knife::stick(float targetX, float targetY, float targetRotation) {
     float adjustedDistance = distanceFromCenter - GameConstants::KNIFE_IMAGE_TIP_OFFSET;
     x = targetX + adjustedDistance * cos(currentAngle);
     y = targetY + adjustedDistance * sin(currentAngle);
+    previousY = y;
 
     // Keep visual appearance identical (no sprite rotation)
     rotation = 0.0f;
 }
 
-// NEW: Update position of stuck knife as target rotates
-void Knife::updateStuckPosition(float targetX, float targetY, float targetRotation) {
-    if (!isStuck) return;
-
-    // Calculate current angle based on target rotation
-    float currentAngle = (stuckAngle + targetRotation) * M_PI / 180.0f;
-
-    // Update position based on distance and angle
-    float adjustedDistance = distanceFromCenter - GameConstants::KNIFE_IMAGE_TIP_OFFSET;
-    x = targetX + adjustedDistance * cos(currentAngle);
-    y = targetY + adjustedDistance * sin(currentAngle);
-
-    // Update rotation to always point outward
-    rotation = stuckAngle + targetRotation - 90.0f;
-}
-
 float Knife::getHandleX() const {
     if (!isStuck) return x;
 
@@ -0,0 +1,109 @@
+#include "../include/Logger.hpp"
+#include <chrono>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+
+namespace {
+    const char* levelTag(LogLevel level) {
+        switch (level) {
+        case LogLevel::Debug: return "[DEBUG] ";
+        case LogLevel::Info: return "[INFO] ";
+        case LogLevel::Warn: return "[WARN] ";
+        case LogLevel::Error: return "[ERROR] ";
+        }
+        return "";
+    }
+}
+
+Logger::Logger()
+    : enqueuePos(0)
+    , dequeuePos(0)
+    , dropped(0)
+    , running(true) {
+    for (size_t i = 0; i < CAPACITY; i++) {
+        records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    drainThread = std::thread(&Logger::drainLoop, this);
+}
+
+Logger::~Logger() {
+    running.store(false, std::memory_order_release);
+    if (drainThread.joinable()) {
+        drainThread.join();
+    }
+    flush();
+
+    unsigned long long lost = getDroppedCount();
+    if (lost > 0) {
+        fprintf(stderr, "[WARN] Logger dropped %llu messages (ring buffer full)\n", lost);
+    }
+}
+
+void Logger::write(LogLevel level, const char* format, ...) {
+    // Claim a slot (bounded MPMC queue, Vyukov-style sequence numbers)
+    size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Record* record;
+    for (;;) {
+        record = &records[pos & (CAPACITY - 1)];
+        size_t sequence = record->sequence.load(std::memory_order_acquire);
+        intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->level = level;
+    va_list args;
+    va_start(args, format);
+    vsnprintf(record->message, MESSAGE_SIZE, format, args);
+    va_end(args);
+
+    record->sequence.store(pos + 1, std::memory_order_release);
+}
+
+void Logger::flush() {
+    drain();
+    fflush(stdout);
+    fflush(stderr);
+}
+
+size_t Logger::drain() {
+    std::lock_guard<std::mutex> lock(drainMutex);
+
+    size_t drained = 0;
+    for (;;) {
+        Record& record = records[dequeuePos & (CAPACITY - 1)];
+        if (record.sequence.load(std::memory_order_acquire) != dequeuePos + 1) {
+            break;
+        }
+
+        FILE* stream = record.level >= LogLevel::Warn ? stderr : stdout;
+        fputs(levelTag(record.level), stream);
+        fputs(record.message, stream);
+        fputc('\n', stream);
+
+        record.sequence.store(dequeuePos + CAPACITY, std::memory_order_release);
+        dequeuePos++;
+        drained++;
+    }
+    return drained;
+}
+
+void Logger::drainLoop() {
+    while (running.load(std::memory_order_acquire)) {
+        if (drain() == 0) {
+            fflush(stdout);
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+    }
+}
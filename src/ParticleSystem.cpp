@@ -0,0 +1,115 @@
+#include "../include/ParticleSystem.hpp"
+#include "../include/GameConstants.hpp"
+#include <cmath>
+
+namespace {
+    const uint32_t CHIP_COLORS[] = { 0xDAA569, 0xB98755, 0x8B5A2B };  // Light, main and dark wood
+    const uint32_t SPARK_COLORS[] = { 0xFFFFFF, 0xFFE680, 0xFFCC00 };
+}
+
+ParticleSystem::ParticleSystem(size_t capacity)
+    : capacity(capacity)
+    , count(0)
+    , rngState(0x9E3779B9u)
+    , xs(capacity)
+    , ys(capacity)
+    , velocityXs(capacity)
+    , velocityYs(capacity)
+    , gravities(capacity)
+    , rotations(capacity)
+    , spins(capacity)
+    , ages(capacity)
+    , lifetimes(capacity)
+    , sizes(capacity)
+    , colors(capacity)
+    , kinds(capacity) {
+}
+
+void ParticleSystem::emitWoodChips(float x, float y, float dirX, float dirY, int amount) {
+    float baseAngle = std::atan2(dirY, dirX);
+    for (int i = 0; i < amount; i++) {
+        float angle = baseAngle + random(-1.1f, 1.1f);
+        float speed = random(120.0f, 420.0f);
+        spawn(ParticleKind::WOOD_CHIP, x + random(-4.0f, 4.0f), y,
+            std::cos(angle) * speed, std::sin(angle) * speed, 1400.0f,
+            random(-720.0f, 720.0f), random(0.35f, 0.7f), random(3.0f, 7.0f),
+            CHIP_COLORS[i % 3]);
+    }
+}
+
+void ParticleSystem::emitSparks(float x, float y, int amount) {
+    for (int i = 0; i < amount; i++) {
+        float angle = random(0.0f, 2.0f * static_cast<float>(M_PI));
+        float speed = random(200.0f, 650.0f);
+        spawn(ParticleKind::SPARK, x, y, std::cos(angle) * speed, std::sin(angle) * speed, 600.0f,
+            0.0f, random(0.15f, 0.45f), random(2.0f, 3.5f), SPARK_COLORS[i % 3]);
+    }
+}
+
+void ParticleSystem::emitKnife(float x, float y) {
+    // Knocked back down and to one side, tumbling
+    float side = random(0.0f, 1.0f) < 0.5f ? -1.0f : 1.0f;
+    spawn(ParticleKind::KNIFE, x, y, side * random(90.0f, 180.0f), random(250.0f, 350.0f), 1800.0f,
+        side * random(540.0f, 900.0f), 1.2f, 1.0f, 0xFFFFFF);
+}
+
+void ParticleSystem::update(float deltaTime) {
+    // Integrate every live particle in one branch-free pass over the arrays
+    const size_t n = count;
+    for (size_t i = 0; i < n; i++) {
+        velocityYs[i] += gravities[i] * deltaTime;
+        xs[i] += velocityXs[i] * deltaTime;
+        ys[i] += velocityYs[i] * deltaTime;
+        rotations[i] += spins[i] * deltaTime;
+        ages[i] += deltaTime;
+    }
+
+    // Then drop the expired ones, filling each hole from the end
+    size_t i = 0;
+    while (i < count) {
+        if (ages[i] < lifetimes[i]) {
+            i++;
+            continue;
+        }
+        size_t last = --count;
+        xs[i] = xs[last];
+        ys[i] = ys[last];
+        velocityXs[i] = velocityXs[last];
+        velocityYs[i] = velocityYs[last];
+        gravities[i] = gravities[last];
+        rotations[i] = rotations[last];
+        spins[i] = spins[last];
+        ages[i] = ages[last];
+        lifetimes[i] = lifetimes[last];
+        sizes[i] = sizes[last];
+        colors[i] = colors[last];
+        kinds[i] = kinds[last];
+    }
+}
+
+void ParticleSystem::spawn(ParticleKind kind, float x, float y, float velocityX, float velocityY, float gravity,
+    float spin, float lifetime, float size, uint32_t color) {
+    if (count >= capacity) return;  // Full: a missing chip is better than an allocation
+
+    size_t i = count++;
+    kinds[i] = kind;
+    xs[i] = x;
+    ys[i] = y;
+    velocityXs[i] = velocityX;
+    velocityYs[i] = velocityY;
+    gravities[i] = gravity;
+    rotations[i] = kind == ParticleKind::KNIFE ? 0.0f : random(0.0f, 360.0f);  // The knife starts upright
+    spins[i] = spin;
+    ages[i] = 0.0f;
+    lifetimes[i] = lifetime;
+    sizes[i] = size;
+    colors[i] = color;
+}
+
+float ParticleSystem::random(float min, float max) {
+    // xorshift32: plenty for cosmetics, and keeps the gameplay RNG untouched
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return min + (max - min) * ((rngState >> 8) * (1.0f / 16777216.0f));
+}
@@ -1,373 +1,499 @@
 #include "../include/Renderer.hpp"
 #include "../include/FontManager.hpp"
-#include <iostream>
+#include "../include/Logger.hpp"
+#include <cstdio>
+#include <algorithm>
 #include <cmath>
 #include <vector>
 
-Renderer::Renderer(SDL_Window* window) : window(window), renderer(nullptr),
-backgroundTexture(nullptr), targetTexture(nullptr), knifeTexture(nullptr) {}
+Renderer::Renderer(SDL_Window* window) : window(window), targetSurface(nullptr), renderer(nullptr),
+vsyncEnabled(false), staticLayer(nullptr), staticLayerKind(StaticLayer::NONE), staticLayerValue(0),
+animationTimeMs(-1), renderScale(1.0f), playfieldTarget(nullptr), playfieldActive(false) {}
+
+Renderer::Renderer(SDL_Surface* targetSurface) : window(nullptr), targetSurface(targetSurface), renderer(nullptr),
+vsyncEnabled(false), staticLayer(nullptr), staticLayerKind(StaticLayer::NONE), staticLayerValue(0),
+animationTimeMs(-1), renderScale(1.0f), playfieldTarget(nullptr), playfieldActive(false) {}
 
 Renderer::~Renderer() {
-    cleanupBackgroundTexture();
-    cleanupTargetTexture();
-    cleanupKnifeTexture();  // NEW
+    if (staticLayer) {
+        SDL_DestroyTexture(staticLayer);
+    }
+    if (playfieldTarget) {
+        SDL_DestroyTexture(playfieldTarget);
+    }
+    sprites.destroyTexture();
+    textCache.clear();
+    FontManager::getInstance().destroyAtlasTextures();
     if (renderer) {
         SDL_DestroyRenderer(renderer);
     }
 }
 
-bool Renderer::initialize() {
-    renderer = SDL_CreateRenderer(window, nullptr);
-    if (!renderer) {
-        std::cout << "Renderer could not be created! Error: " << SDL_GetError() << std::endl;
+bool Renderer::initialize(const AssetArchive* assets) {
+    AssetLoader loader;
+    if (!beginInitialize(loader, assets)) {
         return false;
     }
+    loader.wait();
+    return finishInitialize();
+}
 
-    // Initialize font manager
-    if (!FontManager::getInstance().initialize()) {
-        std::cout << "Failed to initialize font manager!" << std::endl;
+bool Renderer::beginInitialize(AssetLoader& loader, const AssetArchive* assets) {
+    renderer = window ? SDL_CreateRenderer(window, nullptr) : SDL_CreateSoftwareRenderer(targetSurface);
+    if (!renderer) {
+        KH_LOG_ERROR("Renderer could not be created! Error: %s", SDL_GetError());
         return false;
     }
 
-    // Load background texture
-    if (!loadBackgroundTexture()) {
-        std::cout << "Failed to load background texture!" << std::endl;
-        return false;
-    }
+    // Let present() pace the loop to the display refresh rate when supported
+    if (window) {
+        vsyncEnabled = SDL_SetRenderVSync(renderer, 1);
+        if (!vsyncEnabled) {
+            KH_LOG_WARN("VSync not available, running unpaced: %s", SDL_GetError());
+        }
 
-    // Load target texture
-    if (!loadTargetTexture()) {
-        std::cout << "Failed to load target texture!" << std::endl;
-        return false;
+        // Layout stays in GameConstants units; SDL maps them onto however
+        // many pixels the window actually has
+        SDL_SetRenderLogicalPresentation(renderer, GameConstants::SCREEN_WIDTH, GameConstants::SCREEN_HEIGHT,
+            SDL_LOGICAL_PRESENTATION_LETTERBOX);
     }
 
-    // Load knife texture
-    if (!loadKnifeTexture()) {
-        std::cout << "Failed to load knife texture!" << std::endl;
+    // Fonts and images decode on the loader's threads
+    if (!FontManager::getInstance().loadAsync(loader, assets)) {
+        KH_LOG_ERROR("Failed to initialize font manager!");
         return false;
     }
-
+    sprites.loadAsync(loader, assets);
     return true;
 }
 
-bool Renderer::loadBackgroundTexture() {
-    // Load the background image
-    SDL_Surface* surface = SDL_LoadBMP("assets/images/background.bmp");
-    if (!surface) {
-        std::cout << "Failed to load background image: " << SDL_GetError() << std::endl;
+bool Renderer::finishInitialize() {
+    // Textures can only be created on the render thread
+    if (!FontManager::getInstance().finishLoading()) {
+        KH_LOG_ERROR("Failed to initialize font manager!");
         return false;
     }
+    FontManager::getInstance().createAtlasTextures(renderer);
 
-    backgroundTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
-
-    if (!backgroundTexture) {
-        std::cout << "Failed to create background texture: " << SDL_GetError() << std::endl;
+    // Pack background, target, knife and bullseye into one texture at the
+    // output resolution; missing images get procedural stand-ins, so this
+    // only fails without memory
+    if (!sprites.build(computeOutputScale()) || !sprites.createTexture(renderer)) {
+        KH_LOG_ERROR("Failed to create sprite atlas!");
         return false;
     }
 
     return true;
 }
 
-bool Renderer::loadTargetTexture() {
-    // Load the target image
-    SDL_Surface* surface = SDL_LoadBMP("assets/images/target.bmp");
-    if (!surface) {
-        std::cout << "Failed to load target image: " << SDL_GetError() << std::endl;
-        return false;
-    }
-
-    targetTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
+void Renderer::renderLoadingScreen(float progress) {
+    using namespace GameConstants;
+    SDL_SetRenderDrawColor(renderer, Colors::BACKGROUND_DARK.r, Colors::BACKGROUND_DARK.g,
+        Colors::BACKGROUND_DARK.b, 255);
+    SDL_RenderClear(renderer);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
 
-    if (!targetTexture) {
-        std::cout << "Failed to create target texture: " << SDL_GetError() << std::endl;
-        return false;
+    // Ring of dots with a bright head going round, one lap per second
+    const int dotCount = 12;
+    const float spinnerRadius = 28.0f;
+    const float dotSize = 8.0f;
+    const float centerX = SCREEN_WIDTH / 2.0f;
+    const float centerY = SCREEN_HEIGHT / 2.0f - 30.0f;
+    int head = static_cast<int>(SDL_GetTicks() * dotCount / 1000) % dotCount;
+    for (int i = 0; i < dotCount; i++) {
+        float angle = i * 2.0f * static_cast<float>(M_PI) / dotCount;
+        int behind = (head - i + dotCount) % dotCount;
+        SDL_SetRenderDrawColor(renderer, 255, 255, 255, static_cast<Uint8>(255 - behind * 200 / dotCount));
+        SDL_FRect dot = { centerX + std::cos(angle) * spinnerRadius - dotSize / 2,
+            centerY + std::sin(angle) * spinnerRadius - dotSize / 2, dotSize, dotSize };
+        SDL_RenderFillRect(renderer, &dot);
     }
 
-    return true;
+    // Progress bar: share of load jobs finished
+    const float barW = SCREEN_WIDTH * 0.5f;
+    const float barH = 6.0f;
+    SDL_FRect track = { centerX - barW / 2, centerY + 60.0f, barW, barH };
+    SDL_FRect fill = { track.x, track.y, barW * std::clamp(progress, 0.0f, 1.0f), barH };
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 60);
+    SDL_RenderFillRect(renderer, &track);
+    SDL_SetRenderDrawColor(renderer, Colors::GREEN.r, Colors::GREEN.g, Colors::GREEN.b, 255);
+    SDL_RenderFillRect(renderer, &fill);
 }
 
-bool Renderer::loadKnifeTexture() {
-    SDL_Surface* surface = SDL_LoadBMP("assets/images/knife.bmp");
-    if (!surface) {
-        std::cout << "Failed to load knife image: " << SDL_GetError() << std::endl;
-        return false;
+float Renderer::computeOutputScale() const {
+    int width = 0, height = 0;
+    if (!SDL_GetRenderOutputSize(renderer, &width, &height) || width <= 0 || height <= 0) {
+        return sprites.getScale();  // Minimized; keep what we have
     }
+    // Letterboxing fits the layout by the tighter axis
+    return std::min(static_cast<float>(width) / GameConstants::SCREEN_WIDTH,
+        static_cast<float>(height) / GameConstants::SCREEN_HEIGHT);
+}
 
-    knifeTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    SDL_DestroySurface(surface);
+void Renderer::handleResize() {
+    float scale = computeOutputScale();
+    // Small changes still sample close to 1:1; don't repack on every drag step
+    if (std::fabs(scale - sprites.getScale()) < sprites.getScale() * 0.05f) return;
 
-    if (!knifeTexture) {
-        std::cout << "Failed to create knife texture: " << SDL_GetError() << std::endl;
-        return false;
+    // Repacks from the decoded images kept by the atlas, no file reads
+    if (!sprites.build(scale) || !sprites.createTexture(renderer)) {
+        KH_LOG_ERROR("Failed to rebuild sprite atlas at %.2fx", scale);
     }
 
-    return true;
+    // The static layer and playfield target are sized in output pixels too
+    if (staticLayer) {
+        SDL_DestroyTexture(staticLayer);
+        staticLayer = nullptr;
+    }
+    staticLayerKind = StaticLayer::NONE;
+    destroyPlayfieldTarget();
+}
+
+void Renderer::setRenderScale(float scale) {
+    scale = std::clamp(scale, MIN_RENDER_SCALE, 1.0f);
+    if (scale == renderScale) return;
+    renderScale = scale;
+    destroyPlayfieldTarget();
 }
 
-void Renderer::cleanupKnifeTexture() {
-    if (knifeTexture) {
-        SDL_DestroyTexture(knifeTexture);
-        knifeTexture = nullptr;
+void Renderer::destroyPlayfieldTarget() {
+    if (playfieldTarget) {
+        SDL_DestroyTexture(playfieldTarget);
+        playfieldTarget = nullptr;
+    }
+}
+
+void Renderer::beginPlayfield() {
+    // Native resolution draws straight into the frame
+    if (renderScale < 1.0f) {
+        const float scale = sprites.getScale() * renderScale;
+        if (!playfieldTarget) {
+            playfieldTarget = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                std::max(1, static_cast<int>(std::ceil(GameConstants::SCREEN_WIDTH * scale))),
+                std::max(1, static_cast<int>(std::ceil(GameConstants::SCREEN_HEIGHT * scale))));
+            if (playfieldTarget) {
+                SDL_SetTextureBlendMode(playfieldTarget, SDL_BLENDMODE_NONE);
+                SDL_SetTextureScaleMode(playfieldTarget, SDL_SCALEMODE_LINEAR);
+            }
+            else {
+                KH_LOG_WARN("Reduced-resolution playfield unavailable, drawing at native size: %s", SDL_GetError());
+                renderScale = 1.0f;
+            }
+        }
+        playfieldActive = playfieldTarget && SDL_SetRenderTarget(renderer, playfieldTarget);
+        if (playfieldActive) {
+            SDL_SetRenderScale(renderer, scale, scale);  // Gameplay coordinates stay in layout units
+        }
     }
+    clear();
+}
+
+void Renderer::endPlayfield() {
+    if (!playfieldActive) return;
+    flushSprites();
+    SDL_SetRenderTarget(renderer, nullptr);
+    playfieldActive = false;
+
+    // One upscaling blit for the whole playfield
+    clear();
+    SDL_RenderTexture(renderer, playfieldTarget, nullptr, nullptr);
 }
 
-void Renderer::cleanupBackgroundTexture() {
-    if (backgroundTexture) {
-        SDL_DestroyTexture(backgroundTexture);
-        backgroundTexture = nullptr;
+bool Renderer::setVSync(int interval) {
+    if (!SDL_SetRenderVSync(renderer, interval)) {
+        KH_LOG_WARN("Failed to set vsync interval %d: %s", interval, SDL_GetError());
+        return false;
     }
+    vsyncEnabled = interval != 0;
+    return true;
 }
 
-void Renderer::cleanupTargetTexture() {
-    if (targetTexture) {
-        SDL_DestroyTexture(targetTexture);
-        targetTexture = nullptr;
+SDL_Surface* Renderer::readPixels() {
+    flushSprites();
+    SDL_Surface* pixels = SDL_RenderReadPixels(renderer, nullptr);
+    if (!pixels) {
+        KH_LOG_ERROR("Failed to read back frame: %s", SDL_GetError());
     }
+    return pixels;
 }
 
 void Renderer::clear() {
     SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
     SDL_RenderClear(renderer);
+    spriteBatch.begin(sprites.getTexture());
 }
 
 void Renderer::present() {
+    flushSprites();
     SDL_RenderPresent(renderer);
 }
 
+void Renderer::flushSprites() {
+    spriteBatch.flush(renderer);
+}
+
 void Renderer::renderBackground() {
-    if (backgroundTexture) {
-        // Scale and render the background image to fit the screen
-        SDL_FRect destRect = {
-            0, 0,
-            static_cast<float>(GameConstants::SCREEN_WIDTH),
-            static_cast<float>(GameConstants::SCREEN_HEIGHT)
-        };
-        SDL_RenderTexture(renderer, backgroundTexture, nullptr, &destRect);
-    }
-    else {
-        // Fallback to gradient background if image fails to load
-        for (int y = 0; y < GameConstants::SCREEN_HEIGHT; y++) {
-            float t = static_cast<float>(y) / GameConstants::SCREEN_HEIGHT;
-
-            Uint8 r = static_cast<Uint8>(GameConstants::Colors::BACKGROUND_TOP.r * (1 - t) + GameConstants::Colors::BACKGROUND_BOTTOM.r * t);
-            Uint8 g = static_cast<Uint8>(GameConstants::Colors::BACKGROUND_TOP.g * (1 - t) + GameConstants::Colors::BACKGROUND_BOTTOM.g * t);
-            Uint8 b = static_cast<Uint8>(GameConstants::Colors::BACKGROUND_TOP.b * (1 - t) + GameConstants::Colors::BACKGROUND_BOTTOM.b * t);
-
-            SDL_SetRenderDrawColor(renderer, r, g, b, 255);
-            SDL_RenderLine(renderer, 0, y, GameConstants::SCREEN_WIDTH, y);
-        }
-    }
+    // Fill the screen with the background image
+    spriteBatch.add(GameConstants::SCREEN_WIDTH / 2.0f, GameConstants::SCREEN_HEIGHT / 2.0f,
+        static_cast<float>(GameConstants::SCREEN_WIDTH), static_cast<float>(GameConstants::SCREEN_HEIGHT),
+        0.0f, sprites.getRegion(SpriteId::BACKGROUND).uv);
 }
 
-void Renderer::renderTarget(const Target& target) {
+void Renderer::renderTarget(const Target& target, float rotation) {
     float centerX = target.getX();
     float centerY = target.getY();
-    float rotation = target.getRotation();
     float radius = target.getRadius();
 
-    if (targetTexture) {
-        // Calculate the destination rectangle (centered on target position)
-        float diameter = radius * 2.0f;
-        SDL_FRect destRect = {
-            centerX - radius,  // Center the image on target position
-            centerY - radius,
-            diameter,
-            diameter
-        };
-
-        // Create rotation point (center of the target)
-        SDL_FPoint center = {
-            radius,  // Center point relative to destRect
-            radius
-        };
-
-        // Render the rotated target image
-        SDL_RenderTextureRotated(renderer, targetTexture, nullptr, &destRect,
-            rotation, &center, SDL_FLIP_NONE);
-    }
-    else {
-        // Fallback to original geometric rendering if texture fails to load
-        SDL_SetRenderDrawColor(renderer,
-            GameConstants::Colors::WOOD.r,
-            GameConstants::Colors::WOOD.g,
-            GameConstants::Colors::WOOD.b, 255);
-
-        // Draw filled circle with better algorithm
-        int radiusInt = static_cast<int>(radius);
-        for (int w = -radiusInt; w <= radiusInt; w++) {
-            for (int h = -radiusInt; h <= radiusInt; h++) {
-                if ((w * w + h * h) <= (radiusInt * radiusInt)) {
-                    SDL_RenderPoint(renderer, centerX + w, centerY + h);
-                }
-            }
-        }
+    // Target image rotated about its center, with the bullseye turning with it
+    float radians = rotation * static_cast<float>(M_PI) / 180.0f;
+    float cosRotation = std::cos(radians);
+    float sinRotation = std::sin(radians);
+    spriteBatch.add(centerX, centerY, radius * 2.0f, radius * 2.0f, cosRotation, sinRotation,
+        sprites.getRegion(SpriteId::TARGET).uv);
 
-        // Draw concentric rings
-        SDL_SetRenderDrawColor(renderer,
-            GameConstants::Colors::WOOD_DARK.r,
-            GameConstants::Colors::WOOD_DARK.g,
-            GameConstants::Colors::WOOD_DARK.b, 255);
-
-        for (int ring = 20; ring < radiusInt; ring += 20) {
-            for (int angle = 0; angle < 360; angle += 2) {
-                float radians = angle * M_PI / 180.0f;
-                int x = centerX + ring * cos(radians);
-                int y = centerY + ring * sin(radians);
-                SDL_RenderPoint(renderer, x, y);
-            }
-        }
+    float bullseyeSize = GameConstants::BULLSEYE_RADIUS * 2.0f;
+    spriteBatch.add(centerX, centerY, bullseyeSize, bullseyeSize, cosRotation, sinRotation,
+        sprites.getRegion(SpriteId::BULLSEYE).uv);
+}
 
-        // Draw center bullseye
-        SDL_SetRenderDrawColor(renderer,
-            GameConstants::Colors::RED.r,
-            GameConstants::Colors::RED.g,
-            GameConstants::Colors::RED.b, 255);
-
-        for (int w = -10; w <= 10; w++) {
-            for (int h = -10; h <= 10; h++) {
-                if ((w * w + h * h) <= 100) {
-                    SDL_RenderPoint(renderer, centerX + w, centerY + h);
-                }
-            }
+void Renderer::renderKnife(const Knife& knife, float y, bool useRotation) {
+    if (!knife.isKnifeActive()) return;
+
+    // Stuck knives turn with the target; the flying knife stays upright
+    float rotation = useRotation && knife.isKnifeStuck() ? knife.getRotation() : 0.0f;
+    spriteBatch.add(knife.getX(), y, GameConstants::KNIFE_WIDTH, GameConstants::KNIFE_LENGTH,
+        rotation, sprites.getRegion(SpriteId::KNIFE).uv);
+}
+
+void Renderer::renderKnives(const StuckKnifeStore& knives, size_t count, float centerX, float centerY, float rotationDelta) {
+    // The sprite is turned 90 degrees back from the knife's direction, so
+    // cos/sin of its rotation are (dirY, -dirX) and no trig is needed here
+    const SDL_FRect& uv = sprites.getRegion(SpriteId::KNIFE).uv;
+    if (rotationDelta == 0.0f) {
+        for (size_t i = 0; i < count; i++) {
+            spriteBatch.add(knives.getX(i), knives.getY(i), GameConstants::KNIFE_WIDTH, GameConstants::KNIFE_LENGTH,
+                knives.getDirectionY(i), -knives.getDirectionX(i), uv);
         }
+        return;
     }
-}
 
-void Renderer::renderKnife(const Knife& knife, bool useRotation) {
-    if (!knife.isKnifeActive()) return;
+    // Interpolated frames: one sincos, then every knife's offset from the
+    // center and its direction are turned by the same rotation
+    float radians = rotationDelta * static_cast<float>(M_PI) / 180.0f;
+    float cosDelta = std::cos(radians);
+    float sinDelta = std::sin(radians);
+    for (size_t i = 0; i < count; i++) {
+        float offsetX = knives.getX(i) - centerX;
+        float offsetY = knives.getY(i) - centerY;
+        float directionX = knives.getDirectionX(i) * cosDelta - knives.getDirectionY(i) * sinDelta;
+        float directionY = knives.getDirectionX(i) * sinDelta + knives.getDirectionY(i) * cosDelta;
+        spriteBatch.add(centerX + offsetX * cosDelta - offsetY * sinDelta, centerY + offsetX * sinDelta + offsetY * cosDelta,
+            GameConstants::KNIFE_WIDTH, GameConstants::KNIFE_LENGTH, directionY, -directionX, uv);
+    }
+}
 
-    float x = knife.getX();
-    float y = knife.getY();
-
-    if (knifeTexture) {
-        // Use knife image
-        SDL_FRect destRect = {
-            x - GameConstants::KNIFE_WIDTH / 2,
-            y - GameConstants::KNIFE_LENGTH / 2,
-            GameConstants::KNIFE_WIDTH,
-            GameConstants::KNIFE_LENGTH
-        };
-
-        if (useRotation && knife.isKnifeStuck()) {
-            // Render rotated stuck knife
-            SDL_FPoint center = {
-                GameConstants::KNIFE_WIDTH / 2,
-                GameConstants::KNIFE_LENGTH / 2
-            };
-            SDL_RenderTextureRotated(renderer, knifeTexture, nullptr, &destRect,
-                knife.getRotation(), &center, SDL_FLIP_NONE);
+void Renderer::renderParticles(const ParticleSystem& particles) {
+    const SDL_FRect& dot = sprites.getRegion(SpriteId::PARTICLE).uv;
+    // Chips sample the solid middle of the dot, so they come out square
+    const SDL_FRect chip = { dot.x + dot.w * 0.3f, dot.y + dot.h * 0.3f, dot.w * 0.4f, dot.h * 0.4f };
+    const SDL_FRect& knife = sprites.getRegion(SpriteId::KNIFE).uv;
+    const float degToRad = static_cast<float>(M_PI) / 180.0f;
+
+    for (size_t i = 0; i < particles.getCount(); i++) {
+        uint32_t rgb = particles.getColor(i);
+        SDL_FColor color = { ((rgb >> 16) & 0xFF) / 255.0f, ((rgb >> 8) & 0xFF) / 255.0f, (rgb & 0xFF) / 255.0f,
+            particles.getAlpha(i) };
+        float x = particles.getX(i);
+        float y = particles.getY(i);
+        float size = particles.getSize(i);
+
+        switch (particles.getKind(i)) {
+        case ParticleKind::SPARK: {
+            // Streak along the direction of travel
+            float vx = particles.getVelocityX(i);
+            float vy = particles.getVelocityY(i);
+            float speed = std::sqrt(vx * vx + vy * vy);
+            if (speed <= 0.0f) break;
+            spriteBatch.add(x, y, size, size * 4.0f, vy / speed, -vx / speed, dot, color);
+            break;
         }
-        else {
-            // Render normal upright knife
-            SDL_RenderTexture(renderer, knifeTexture, nullptr, &destRect);
+        case ParticleKind::KNIFE: {
+            float radians = particles.getRotation(i) * degToRad;
+            spriteBatch.add(x, y, GameConstants::KNIFE_WIDTH, GameConstants::KNIFE_LENGTH,
+                std::cos(radians), std::sin(radians), knife, color);
+            break;
+        }
+        case ParticleKind::WOOD_CHIP: {
+            float radians = particles.getRotation(i) * degToRad;
+            spriteBatch.add(x, y, size, size, std::cos(radians), std::sin(radians), chip, color);
+            break;
         }
-    }
-    else {
-        // Fallback to geometric rendering
-        SDL_SetRenderDrawColor(renderer, 139, 69, 19, 255);
-        SDL_FRect handleRect = {
-            x - GameConstants::KNIFE_WIDTH / 2,
-            y + GameConstants::KNIFE_LENGTH / 3,
-            static_cast<float>(GameConstants::KNIFE_WIDTH),
-            static_cast<float>(GameConstants::KNIFE_LENGTH / 3)
-        };
-        SDL_RenderFillRect(renderer, &handleRect);
-
-        SDL_SetRenderDrawColor(renderer, 192, 192, 192, 255);
-        SDL_FRect bladeRect = {
-            x - GameConstants::KNIFE_WIDTH / 2,
-            y - GameConstants::KNIFE_LENGTH / 3,
-            static_cast<float>(GameConstants::KNIFE_WIDTH),
-            static_cast<float>(GameConstants::KNIFE_LENGTH * 2 / 3)
-        };
-        SDL_RenderFillRect(renderer, &bladeRect);
-    }
-}
-
-void Renderer::renderKnives(const std::vector<Knife>& knives) {
-    for (const auto& knife : knives) {
-        if (knife.isKnifeStuck()) {
-            renderKnife(knife, true);  // CHANGED: Use rotation for stuck knives
         }
     }
 }
 
 void Renderer::renderKnifeIndicators(int knivesLeft) {
-    if (!knifeTexture) {
-        // Fallback to original geometric indicators
-        // ... keep existing geometric code ...
-        return;
-    }
-
     // Use knife image for indicators
     float startX = 30.0f;
     float startY = GameConstants::KNIFE_INDICATOR_Y;
     float scale = GameConstants::KNIFE_INDICATOR_SCALE;
 
+    // Rotate 45 degrees for indicator style
+    const float cos45 = static_cast<float>(M_SQRT1_2);
+    const float sin45 = static_cast<float>(M_SQRT1_2);
+    const SDL_FRect& uv = sprites.getRegion(SpriteId::KNIFE).uv;
     for (int i = 0; i < knivesLeft; i++) {
         float knifeX = startX;
         float knifeY = startY - (i * GameConstants::KNIFE_INDICATOR_SPACING);
-
-        SDL_FRect destRect = {
-            knifeX - (GameConstants::KNIFE_WIDTH * scale) / 2,
-            knifeY - (GameConstants::KNIFE_LENGTH * scale) / 2,
-            GameConstants::KNIFE_WIDTH * scale,
-            GameConstants::KNIFE_LENGTH * scale
-        };
-
-        // Rotate 45 degrees for indicator style
-        SDL_FPoint center = {
-            (GameConstants::KNIFE_WIDTH * scale) / 2,
-            (GameConstants::KNIFE_LENGTH * scale) / 2
-        };
-
-        SDL_RenderTextureRotated(renderer, knifeTexture, nullptr, &destRect,
-            45.0f, &center, SDL_FLIP_NONE);
+        spriteBatch.add(knifeX, knifeY, GameConstants::KNIFE_WIDTH * scale, GameConstants::KNIFE_LENGTH * scale,
+            cos45, sin45, uv);
     }
 }
 
 void Renderer::renderText(const std::string& text, int x, int y,
-    const SDL_Color& color, bool centered, const std::string& fontName) {
-    TTF_Font* font = FontManager::getInstance().getFont(fontName);
-    if (!font) {
-        std::cerr << "Font not found: " << fontName << std::endl;
+    const SDL_Color& color, bool centered, FontHandle fontHandle) {
+    flushSprites();  // Keep draw order: sprites queued so far go underneath
+
+    // Printable ASCII goes through the font's glyph atlas as one geometry batch.
+    // Loads the variant on first use; failures are logged once by the manager.
+    GlyphAtlas* atlas = FontManager::getInstance().getAtlas(fontHandle);
+    if (atlas && atlas->getTexture() && atlas->canRender(text)) {
+        renderTextGeometry(*atlas, text, x, y, color, centered);
         return;
     }
 
-    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), text.length(), color);
-    if (!surface) {
-        std::cerr << "Failed to create text surface" << std::endl;
+    // Anything else is rasterized by SDL_ttf, started only now if fonts are baked
+    TTF_Font* font = FontManager::getInstance().getFont(fontHandle);
+    if (!font) {
         return;
     }
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!texture) {
-        std::cerr << "Failed to create text texture: " << SDL_GetError() << std::endl;
-        SDL_DestroySurface(surface);
-        return;
-    }
+    const TextTexture* cached = textCache.get(renderer, font, fontHandle, text, color);
+    if (!cached) return;
 
     SDL_FRect dstRect = {
         static_cast<float>(x),
         static_cast<float>(y),
-        static_cast<float>(surface->w),
-        static_cast<float>(surface->h)
+        static_cast<float>(cached->width),
+        static_cast<float>(cached->height)
     };
 
     if (centered) {
-        dstRect.x -= surface->w / 2.0f;
-        dstRect.y -= surface->h / 2.0f;
+        dstRect.x -= cached->width / 2.0f;
+        dstRect.y -= cached->height / 2.0f;
     }
 
-    SDL_DestroySurface(surface);
-    SDL_RenderTexture(renderer, texture, nullptr, &dstRect);
-    SDL_DestroyTexture(texture);
+    // Alpha is applied at draw time so fading text shares one texture
+    SDL_SetTextureAlphaMod(cached->texture, color.a);
+    SDL_RenderTexture(renderer, cached->texture, nullptr, &dstRect);
 }
 
-void Renderer::renderMenu() {
+void Renderer::renderTextGeometry(const GlyphAtlas& atlas, const std::string& text, int x, int y,
+    const SDL_Color& color, bool centered) {
+    float penX = static_cast<float>(x);
+    float penY = static_cast<float>(y);
+    if (centered) {
+        // Whole pixels, so glyph cells sample the atlas 1:1
+        penX = std::floor(penX - atlas.measure(text) / 2.0f);
+        penY = std::floor(penY - atlas.getLineHeight() / 2.0f);
+    }
+
+    const SDL_FColor tint = { color.r / 255.0f, color.g / 255.0f, color.b / 255.0f, color.a / 255.0f };
+    textVertices.clear();
+    textIndices.clear();
+    for (size_t i = 0; i < text.size(); i++) {
+        if (i > 0) penX += atlas.getKerning(text[i - 1], text[i]);
+        const GlyphAtlas::Glyph& glyph = atlas.getGlyph(text[i]);
+
+        if (glyph.source.w > 0.0f) {
+            const SDL_FRect& uv = glyph.uv;
+            int base = static_cast<int>(textVertices.size());
+            textVertices.push_back({ { penX, penY }, tint, { uv.x, uv.y } });
+            textVertices.push_back({ { penX + glyph.source.w, penY }, tint, { uv.x + uv.w, uv.y } });
+            textVertices.push_back({ { penX + glyph.source.w, penY + glyph.source.h }, tint, { uv.x + uv.w, uv.y + uv.h } });
+            textVertices.push_back({ { penX, penY + glyph.source.h }, tint, { uv.x, uv.y + uv.h } });
+            const int quad[] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+            textIndices.insert(textIndices.end(), quad, quad + 6);
+        }
+        penX += glyph.advance;
+    }
+
+    if (!textIndices.empty()) {
+        SDL_RenderGeometry(renderer, atlas.getTexture(), textVertices.data(), static_cast<int>(textVertices.size()),
+            textIndices.data(), static_cast<int>(textIndices.size()));
+    }
+}
+
+bool Renderer::drawStaticLayer(StaticLayer layer, int value) {
+    const float scale = sprites.getScale();
+    if (!staticLayer) {
+        // Same texel density as the sprites, so caching doesn't cost sharpness
+        staticLayer = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+            static_cast<int>(std::ceil(GameConstants::SCREEN_WIDTH * scale)),
+            static_cast<int>(std::ceil(GameConstants::SCREEN_HEIGHT * scale)));
+        if (!staticLayer) {
+            // Render targets unsupported: callers draw everything each frame
+            return false;
+        }
+        // The layer is opaque and replaces the frame, so skip blending
+        SDL_SetTextureBlendMode(staticLayer, SDL_BLENDMODE_NONE);
+        staticLayerKind = StaticLayer::NONE;
+    }
+
+    // Re-render only when the screen (or what it shows) changed
+    if (layer != staticLayerKind || value != staticLayerValue) {
+        SDL_Texture* previousTarget = SDL_GetRenderTarget(renderer);
+        if (!SDL_SetRenderTarget(renderer, staticLayer)) {
+            return false;
+        }
+        SDL_SetRenderScale(renderer, scale, scale);  // Per target: draw in layout units
+        clear();
+        switch (layer) {
+        case StaticLayer::MENU: renderMenuStatic(); break;
+        case StaticLayer::GAME_OVER: renderGameOverStatic(value); break;
+        case StaticLayer::LEVEL_COMPLETE: renderLevelCompleteStatic(); break;
+        default: break;
+        }
+        flushSprites();
+        SDL_SetRenderTarget(renderer, previousTarget);
+
+        staticLayerKind = layer;
+        staticLayerValue = value;
+    }
+
     clear();
+    SDL_RenderTexture(renderer, staticLayer, nullptr, nullptr);
+    return true;
+}
+
+Uint8 Renderer::getPulseAlpha() const {
+    // Slow fade between half and full opacity for the "tap to ..." prompts
+    Uint64 time = animationTimeMs >= 0 ? static_cast<Uint64>(animationTimeMs) : SDL_GetTicks();
+    float pulse = (sin(time / 300.0f) + 1.0f) / 2.0f;
+    return static_cast<Uint8>(128 + 127 * pulse);
+}
+
+void Renderer::invalidateStaticLayer() {
+    staticLayerKind = StaticLayer::NONE;
+}
+
+void Renderer::renderMenu() {
+    if (!drawStaticLayer(StaticLayer::MENU, 0)) {
+        clear();
+        renderMenuStatic();
+    }
+
+    // Pulsing effect for TAP TO PLAY
+    Uint8 alpha = getPulseAlpha();
+    SDL_Color tapColor = { 255, 255, 255, alpha };
+
+    renderText("TAP TO PLAY", GameConstants::SCREEN_WIDTH / 2,
+        GameConstants::SCREEN_HEIGHT * 2 / 3,
+        tapColor, true, FontManager::UI_FONT);
+
+}
+
+void Renderer::renderMenuStatic() {
     renderBackground();
 
     // Title with shadow effect
@@ -389,17 +515,6 @@ void Renderer::renderMenu() {
     renderText("HIT", GameConstants::SCREEN_WIDTH / 2,
         GameConstants::SCREEN_HEIGHT / 3 + 40,
         titleColor, true, FontManager::TITLE_FONT);
-
-    // Pulsing effect for TAP TO PLAY
-    float pulse = (sin(SDL_GetTicks() / 300.0f) + 1.0f) / 2.0f;
-    Uint8 alpha = static_cast<Uint8>(128 + 127 * pulse);
-    SDL_Color tapColor = { 255, 255, 255, alpha };
-
-    renderText("TAP TO PLAY", GameConstants::SCREEN_WIDTH / 2,
-        GameConstants::SCREEN_HEIGHT * 2 / 3,
-        tapColor, true, FontManager::UI_FONT);
-
-    present();
 }
 
 void Renderer::renderHUD(int level, int score) {
@@ -415,10 +530,26 @@ void Renderer::renderHUD(int level, int score) {
 }
 
 void Renderer::renderGameOver(int score) {
-    clear();
+    if (!drawStaticLayer(StaticLayer::GAME_OVER, score)) {
+        clear();
+        renderGameOverStatic(score);
+    }
+
+    // Pulsing restart button
+    Uint8 alpha = getPulseAlpha();
+    SDL_Color restartColor = { 255, 255, 255, alpha };
+
+    renderText("TAP TO RESTART", GameConstants::SCREEN_WIDTH / 2,
+        GameConstants::SCREEN_HEIGHT / 2 + 60,
+        restartColor, true, FontManager::UI_FONT);
+
+}
+
+void Renderer::renderGameOverStatic(int score) {
     renderBackground();
 
     // Red tinted overlay
+    flushSprites();
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 50);
     SDL_RenderFillRect(renderer, nullptr);
@@ -438,23 +569,28 @@ void Renderer::renderGameOver(int score) {
     renderText(scoreText, GameConstants::SCREEN_WIDTH / 2,
         GameConstants::SCREEN_HEIGHT / 2 - 20,
         { 255, 255, 255, 255 }, true, FontManager::UI_FONT);
+}
 
-    // Pulsing restart button
-    float pulse = (sin(SDL_GetTicks() / 300.0f) + 1.0f) / 2.0f;
-    Uint8 alpha = static_cast<Uint8>(128 + 127 * pulse);
-    SDL_Color restartColor = { 255, 255, 255, alpha };
+void Renderer::renderLevelComplete() {
+    if (!drawStaticLayer(StaticLayer::LEVEL_COMPLETE, 0)) {
+        clear();
+        renderLevelCompleteStatic();
+    }
 
-    renderText("TAP TO RESTART", GameConstants::SCREEN_WIDTH / 2,
-        GameConstants::SCREEN_HEIGHT / 2 + 60,
-        restartColor, true, FontManager::UI_FONT);
+    // ADDED: Tap to continue instruction
+    Uint8 alpha = getPulseAlpha();
+    SDL_Color continueColor = { 255, 255, 255, alpha };
+
+    renderText("TAP TO CONTINUE", GameConstants::SCREEN_WIDTH / 2,
+        GameConstants::SCREEN_HEIGHT / 2 + 100,
+        continueColor, true, FontManager::UI_FONT);
 
-    present();
 }
 
-void Renderer::renderLevelComplete() {
-    clear();
+void Renderer::renderLevelCompleteStatic() {
     renderBackground();
 
+    flushSprites();
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 76, 217, 100, 30);
     SDL_RenderFillRect(renderer, nullptr);
@@ -477,56 +613,54 @@ void Renderer::renderLevelComplete() {
     renderText("COMPLETE!", GameConstants::SCREEN_WIDTH / 2,
         GameConstants::SCREEN_HEIGHT / 2 + 20,
         successColor, true, FontManager::TITLE_FONT);
-
-    // ADDED: Tap to continue instruction
-    float pulse = (sin(SDL_GetTicks() / 300.0f) + 1.0f) / 2.0f;
-    Uint8 alpha = static_cast<Uint8>(128 + 127 * pulse);
-    SDL_Color continueColor = { 255, 255, 255, alpha };
-
-    renderText("TAP TO CONTINUE", GameConstants::SCREEN_WIDTH / 2,
-        GameConstants::SCREEN_HEIGHT / 2 + 100,
-        continueColor, true, FontManager::UI_FONT);
-
-    present();
 }
 
-void Renderer::renderGame(const Target& target, const std::vector<Knife>& knives,
-    const Knife& currentKnife, int level, int score, int knivesLeft) {
-    clear();
+void Renderer::renderGame(const Target& target, float targetRotation, const Knife& currentKnife, float knifeY,
+    const ParticleSystem& particles, int level, int score, int knivesLeft) {
+    beginPlayfield();
     renderBackground();
 
     // CHANGED: Render stuck knives FIRST (behind target)
-    renderKnives(knives);
+    const StuckKnifeStore& stuckKnives = target.getStuckKnives();
+    renderKnives(stuckKnives, stuckKnives.size(), target.getX(), target.getY(), targetRotation - target.getRotation());
 
     // CHANGED: Render target AFTER knives (on top)
-    renderTarget(target);
+    renderTarget(target, targetRotation);
 
     // Render current flying knife (always on top)
     if (currentKnife.isKnifeActive() && !currentKnife.isKnifeStuck()) {
-        renderKnife(currentKnife, false);
+        renderKnife(currentKnife, knifeY, false);
     }
+    renderParticles(particles);
+    endPlayfield();
 
+    // HUD stays at full resolution
     renderHUD(level, score);
     renderKnifeIndicators(knivesLeft);
-    present();
 }
 
-void Renderer::renderCollisionPause(const Target& target, const std::vector<Knife>& knives,
-    const Knife& currentKnife, int level, int score, int knivesLeft) {
-    clear();
+void Renderer::renderCollisionPause(const Target& target, float targetRotation, const Knife& currentKnife,
+    const ParticleSystem& particles, int level, int score, int knivesLeft) {
+    beginPlayfield();
     renderBackground();
 
-    // Render stuck knives (behind target)
-    renderKnives(knives);
+    // Render stuck knives (behind target). The colliding knife was stuck last
+    // and is drawn tumbling away as a particle instead.
+    const StuckKnifeStore& stuckKnives = target.getStuckKnives();
+    size_t count = stuckKnives.size() > 0 ? stuckKnives.size() - 1 : 0;
+    renderKnives(stuckKnives, count, target.getX(), target.getY(), targetRotation - target.getRotation());
 
     // Render target
-    renderTarget(target);
+    renderTarget(target, targetRotation);
+    renderParticles(particles);
+    endPlayfield();
 
     // Render HUD
     renderHUD(level, score);
     renderKnifeIndicators(knivesLeft);
 
     // Add visual feedback for collision
+    flushSprites();
     SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 100);  // Red overlay
     SDL_RenderFillRect(renderer, nullptr);
@@ -540,5 +674,78 @@ void Renderer::renderCollisionPause(const Target& target, const std::vector<Knif
         GameConstants::SCREEN_HEIGHT - 130,
         collisionColor, true, FontManager::TITLE_FONT);
 
-    present();
+}
+
+void Renderer::renderProfilerOverlay(const FrameProfiler& profiler, const FramePacer& pacer) {
+    const float panelX = 10.0f;
+    const float panelY = 80.0f;
+    const float panelW = GameConstants::SCREEN_WIDTH - 20.0f;
+    const float panelH = 192.0f;
+    const float graphH = 90.0f;
+    const float graphBottom = panelY + panelH - 10.0f;
+    const float graphRangeMs = 33.3f;  // Two 60 Hz frames tall
+    const float columnW = panelW / FrameProfiler::CAPACITY;
+
+    flushSprites();
+
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 170);
+    SDL_FRect panel = { panelX, panelY, panelW, panelH };
+    SDL_RenderFillRect(renderer, &panel);
+
+    // Stacked per-phase columns, one batched fill per phase
+    static const SDL_Color phaseColors[] = {
+        { 80, 160, 255, 255 },   // events
+        { 76, 217, 100, 255 },   // update
+        { 255, 204, 0, 255 },    // render
+        { 255, 87, 51, 255 },    // present
+    };
+    const size_t phaseCount = static_cast<size_t>(FramePhase::COUNT);
+    SDL_FRect columns[FrameProfiler::CAPACITY];
+    float stackTop[FrameProfiler::CAPACITY];
+    std::fill(stackTop, stackTop + FrameProfiler::CAPACITY, graphBottom);
+
+    for (size_t p = 0; p < phaseCount; p++) {
+        size_t columnCount = 0;
+        for (size_t i = 0; i < profiler.getSampleCount(); i++) {
+            float ms = profiler.getSample(i).phaseMs[p];
+            float h = std::min(ms / graphRangeMs * graphH, stackTop[i] - (graphBottom - graphH));
+            if (h <= 0.0f) continue;
+            stackTop[i] -= h;
+            columns[columnCount++] = { panelX + i * columnW, stackTop[i], columnW, h };
+        }
+        SDL_SetRenderDrawColor(renderer, phaseColors[p].r, phaseColors[p].g, phaseColors[p].b, 220);
+        SDL_RenderFillRects(renderer, columns, static_cast<int>(columnCount));
+    }
+
+    // Frame budget line at the pacing target
+    FramePacer::Stats pacing = pacer.getStats();
+    float budgetY = graphBottom - std::min(pacing.targetMs, graphRangeMs) / graphRangeMs * graphH;
+    SDL_SetRenderDrawColor(renderer, 255, 255, 255, 140);
+    SDL_RenderLine(renderer, panelX, budgetY, panelX + panelW, budgetY);
+
+    FrameProfiler::Stats stats = profiler.computeStats();
+    char line[96];
+    snprintf(line, sizeof(line), "p50 %.2f  p99 %.2f  max %.2f ms",
+        stats.p50Ms, stats.p99Ms, stats.maxMs);
+    renderText(line, static_cast<int>(panelX) + 8, static_cast<int>(panelY) + 6,
+        { 255, 255, 255, 255 }, false, FontManager::DEBUG_FONT);
+
+    snprintf(line, sizeof(line), "ev %.2f  upd %.2f  rnd %.2f  pres %.2f",
+        stats.phaseAverageMs[0], stats.phaseAverageMs[1],
+        stats.phaseAverageMs[2], stats.phaseAverageMs[3]);
+    renderText(line, static_cast<int>(panelX) + 8, static_cast<int>(panelY) + 28,
+        { 200, 200, 200, 255 }, false, FontManager::DEBUG_FONT);
+
+    const TextCache::Stats& text = textCache.getStats();
+    snprintf(line, sizeof(line), "text cache %llu hit / %llu miss  %zu entries  %zu KB",
+        text.hits, text.misses, text.entries, text.bytes / 1024);
+    renderText(line, static_cast<int>(panelX) + 8, static_cast<int>(panelY) + 50,
+        { 200, 200, 200, 255 }, false, FontManager::DEBUG_FONT);
+
+    snprintf(line, sizeof(line), "%s %.1f FPS  jitter %.2f ms  missed %llu",
+        pacer.getMode() == PacingMode::VSYNC ? "vsync" : "sleep", pacer.getTargetFps(),
+        pacing.jitterMs, pacing.missedDeadlines);
+    renderText(line, static_cast<int>(panelX) + 8, static_cast<int>(panelY) + 72,
+        { 200, 200, 200, 255 }, false, FontManager::DEBUG_FONT);
 }
\ No newline at end of file
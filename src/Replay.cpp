@@ -0,0 +1,169 @@
+#include "../include/Replay.hpp"
+#include "../include/GameConstants.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+
+namespace {
+    // File layout (little-endian):
+    //   "KHRP" | version u8 | tick rate u16 | seed u32 | total ticks u64 |
+    //   final state hash u64 | event count u32 | events...
+    // Each event is a varint tick delta from the previous event plus a type byte,
+    // so a typical session is a couple of bytes per tap.
+    const char REPLAY_MAGIC[4] = { 'K', 'H', 'R', 'P' };
+    const uint8_t REPLAY_VERSION = 2;  // 2: state hash covers each stuck knife once
+
+    void writeUInt(std::vector<uint8_t>& out, unsigned long long value, int bytes) {
+        for (int i = 0; i < bytes; i++) {
+            out.push_back(static_cast<uint8_t>(value >> (i * 8)));
+        }
+    }
+
+    void writeVarint(std::vector<uint8_t>& out, unsigned long long value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(static_cast<uint8_t>(value));
+    }
+
+    bool readUInt(const std::vector<uint8_t>& in, size_t& pos, int bytes, unsigned long long& value) {
+        if (pos + bytes > in.size()) return false;
+        value = 0;
+        for (int i = 0; i < bytes; i++) {
+            value |= static_cast<unsigned long long>(in[pos++]) << (i * 8);
+        }
+        return true;
+    }
+
+    bool readVarint(const std::vector<uint8_t>& in, size_t& pos, unsigned long long& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (pos >= in.size()) return false;
+            uint8_t byte = in[pos++];
+            value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) return true;
+        }
+        return false;
+    }
+}
+
+Replay::Replay()
+    : seed(0)
+    , totalTicks(0)
+    , finalStateHash(0)
+    , cursor(0) {
+}
+
+void Replay::begin(unsigned int newSeed) {
+    seed = newSeed;
+    totalTicks = 0;
+    finalStateHash = 0;
+    events.clear();
+    cursor = 0;
+}
+
+void Replay::recordInput(unsigned long long tick, InputEventType type) {
+    events.push_back({ tick, type });
+}
+
+void Replay::finish(const Simulation& simulation) {
+    totalTicks = simulation.getTickCount();
+    finalStateHash = simulation.computeStateHash();
+}
+
+void Replay::applyInputs(Simulation& simulation) {
+    while (cursor < events.size() && events[cursor].tick <= simulation.getTickCount()) {
+        if (events[cursor].type == InputEventType::TAP) {
+            simulation.handleInput();
+        }
+        cursor++;
+    }
+}
+
+bool Replay::saveToFile(const std::string& path) const {
+    std::vector<uint8_t> data;
+    data.insert(data.end(), REPLAY_MAGIC, REPLAY_MAGIC + 4);
+    writeUInt(data, REPLAY_VERSION, 1);
+    writeUInt(data, GameConstants::SIMULATION_TICK_RATE, 2);
+    writeUInt(data, seed, 4);
+    writeUInt(data, totalTicks, 8);
+    writeUInt(data, finalStateHash, 8);
+    writeUInt(data, events.size(), 4);
+
+    unsigned long long previousTick = 0;
+    for (const auto& event : events) {
+        writeVarint(data, event.tick - previousTick);
+        writeUInt(data, static_cast<uint8_t>(event.type), 1);
+        previousTick = event.tick;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file) {
+        KH_LOG_ERROR("Failed to open replay file for writing: %s", path.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(data.data()), data.size());
+    return static_cast<bool>(file);
+}
+
+bool Replay::loadFromFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        KH_LOG_ERROR("Failed to open replay file: %s", path.c_str());
+        return false;
+    }
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    if (data.size() < 4 || !std::equal(REPLAY_MAGIC, REPLAY_MAGIC + 4, data.begin())) {
+        KH_LOG_ERROR("Not a replay file: %s", path.c_str());
+        return false;
+    }
+
+    size_t pos = 4;
+    unsigned long long version, tickRate, fileSeed, ticks, hash, count;
+    if (!readUInt(data, pos, 1, version) || !readUInt(data, pos, 2, tickRate) ||
+        !readUInt(data, pos, 4, fileSeed) || !readUInt(data, pos, 8, ticks) ||
+        !readUInt(data, pos, 8, hash) || !readUInt(data, pos, 4, count)) {
+        KH_LOG_ERROR("Truncated replay header: %s", path.c_str());
+        return false;
+    }
+
+    if (version != REPLAY_VERSION) {
+        KH_LOG_ERROR("Unsupported replay version %llu", version);
+        return false;
+    }
+    if (tickRate != static_cast<unsigned long long>(GameConstants::SIMULATION_TICK_RATE)) {
+        KH_LOG_ERROR("Replay was recorded at %llu ticks/s, this build runs at %d",
+            tickRate, GameConstants::SIMULATION_TICK_RATE);
+        return false;
+    }
+
+    // Each event takes at least two bytes (a one-byte delta and its type), so
+    // a corrupt count is caught before it sizes the allocation
+    if (count > (data.size() - pos) / 2) {
+        KH_LOG_ERROR("Truncated replay events: %s", path.c_str());
+        return false;
+    }
+
+    std::vector<InputEvent> loaded;
+    loaded.reserve(count);
+    unsigned long long tick = 0;
+    for (unsigned long long i = 0; i < count; i++) {
+        unsigned long long delta, type;
+        if (!readVarint(data, pos, delta) || !readUInt(data, pos, 1, type)) {
+            KH_LOG_ERROR("Truncated replay events: %s", path.c_str());
+            return false;
+        }
+        tick += delta;
+        loaded.push_back({ tick, static_cast<InputEventType>(type) });
+    }
+
+    seed = static_cast<unsigned int>(fileSeed);
+    totalTicks = ticks;
+    finalStateHash = hash;
+    events.swap(loaded);
+    cursor = 0;
+    return true;
+}
@@ -0,0 +1,273 @@
+#include "../include/Simulation.hpp"
+#include "../include/GameConstants.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+Simulation::Simulation()
+    : currentState(GameState::MENU)
+    , level(1)
+    , knivesLeft(GameConstants::KNIVES_PER_LEVEL)
+    , score(0)
+    , canThrow(true)
+    , collisionDetected(false)
+    , collisionPauseTimer(0.0f)
+    , gameTime(0)
+    , seed(0)
+    , tickCount(0) {
+    rng.seed(seed);
+    initializeLevel();
+}
+
+void Simulation::reset(unsigned int newSeed) {
+    seed = newSeed;
+    rng.seed(seed);
+    tickCount = 0;
+    impacts.clear();
+    level = 1;
+    score = 0;
+    gameTime = 0;
+    currentState = GameState::MENU;
+    initializeLevel();
+}
+
+unsigned int Simulation::generateSeed() {
+    std::random_device rd;
+    return rd();
+}
+
+unsigned long long Simulation::computeStateHash() const {
+    // FNV-1a over the raw bits, so any float drift changes the hash
+    unsigned long long hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    int state = static_cast<int>(currentState);
+    float rotation = target.getRotation();
+    float knifeY = currentKnife.getY();
+    mix(&tickCount, sizeof(tickCount));
+    mix(&state, sizeof(state));
+    mix(&level, sizeof(level));
+    mix(&score, sizeof(score));
+    mix(&knivesLeft, sizeof(knivesLeft));
+    mix(&rotation, sizeof(rotation));
+    mix(&knifeY, sizeof(knifeY));
+    for (float angle : target.getStuckKnives().getAngles()) {
+        mix(&angle, sizeof(angle));
+    }
+    return hash;
+}
+
+void Simulation::handleInput() {
+    switch (currentState) {
+    case GameState::MENU:
+        currentState = GameState::PLAYING;
+        break;
+
+    case GameState::PLAYING:
+        if (canThrow && knivesLeft > 0 && !currentKnife.isKnifeStuck()) {
+            throwKnife();
+        }
+        break;
+
+    case GameState::GAME_OVER:
+        // Reset game state
+        level = 1;
+        score = 0;
+        initializeLevel();
+        currentState = GameState::MENU;
+        break;
+
+    case GameState::LEVEL_COMPLETE:
+        level++;
+        score += GameConstants::LEVEL_COMPLETE_BONUS;  // Bonus points
+        initializeLevel();
+        currentState = GameState::PLAYING;
+        break;
+    }
+}
+
+void Simulation::update(float deltaTime) {
+    tickCount++;
+    impacts.clear();
+
+    // Handle collision pause state
+    if (currentState == GameState::COLLISION_PAUSE) {
+        collisionPauseTimer -= deltaTime;
+        target.update(deltaTime);  // Keep target rotating during pause
+        updateStuckKnives();       // Keep knives rotating with target
+
+        if (collisionPauseTimer <= 0) {
+            currentState = GameState::GAME_OVER;
+        }
+        return;  // Don't process other game logic during pause
+    }
+
+    if (currentState != GameState::PLAYING) return;
+
+    gameTime += deltaTime;
+    target.update(deltaTime);
+    currentKnife.update(deltaTime);
+
+    // Update stuck knives positions as target rotates
+    updateStuckKnives();
+
+    if (currentKnife.isKnifeActive() && !currentKnife.isKnifeStuck()) {
+        resolveKnifeSweep();
+    }
+}
+
+void Simulation::resolveKnifeSweep() {
+    // Continuous collision: the knife moved from startY to endY during this tick
+    // while the target turned from its previous to its current rotation. Solve
+    // for the fraction of the tick at which the tip reaches the stuck-knife
+    // handles and the rim instead of sampling only the end position, so no tick
+    // length lets the knife skip past the target.
+    float startY = currentKnife.getInterpolatedY(0.0f);
+    float endY = currentKnife.getY();
+    if (endY >= startY) return;  // Not flying toward the target
+
+    float handleRadius = GameConstants::TARGET_RADIUS + GameConstants::KNIFE_IMAGE_HANDLE_OFFSET;
+    float rimY = target.getY() + target.getRadius() + GameConstants::KNIFE_IMAGE_TIP_OFFSET;
+    float handleY = target.getY() + handleRadius + GameConstants::KNIFE_IMAGE_TIP_OFFSET;
+    auto timeAt = [startY, endY](float y) { return (startY - y) / (startY - endY); };
+
+    // Part of this tick the tip spends inside the handle band [rim, handle tips]
+    float enterY = std::min(startY, handleY);
+    float exitY = std::max(endY, rimY);
+    if (enterY >= exitY) {
+        float enterAngle = getIncomingAngle(target.getInterpolatedRotation(timeAt(enterY)));
+        float exitAngle = getIncomingAngle(target.getInterpolatedRotation(timeAt(exitY)));
+
+        if (checkSweptCollision(enterAngle, exitAngle)) {
+            // Don't immediately go to game over - pause for visual feedback
+            collisionDetected = true;
+            collisionPauseTimer = COLLISION_PAUSE_DURATION;
+            currentState = GameState::COLLISION_PAUSE;
+
+            impacts.push_back({ ImpactType::COLLISION, currentKnife.getX(), target.getY() + handleRadius });
+
+            // Still stick the knife at collision point for visual feedback
+            stickCurrentKnife(enterAngle);
+            return;
+        }
+    }
+
+    if (endY > rimY) return;  // Tip hasn't reached the rim yet
+
+    // Stick the knife AT THE EDGE, at the angle it touched the rim
+    impacts.push_back({ ImpactType::STICK, currentKnife.getX(), target.getY() + target.getRadius() });
+    stickCurrentKnife(getIncomingAngle(target.getInterpolatedRotation(timeAt(rimY))));
+
+    // Reset for next throw
+    currentKnife = Knife();
+    currentKnife.reset();
+    currentKnife.setActive(true);
+
+    score += GameConstants::POINTS_PER_KNIFE;
+    canThrow = true;
+
+    if (knivesLeft <= 0) {
+        currentState = GameState::LEVEL_COMPLETE;
+    }
+}
+
+float Simulation::getIncomingAngle(float targetRotation) const {
+    // The knife flies straight up at a fixed x, so where it meets the rim
+    // depends only on the target's rotation at that moment
+    float angle = atan2(target.getRadius(), currentKnife.getX() - target.getX()) * 180.0f / M_PI;
+    angle -= targetRotation;
+    if (angle < 0) angle += 360;
+    if (angle >= 360) angle -= 360;
+    return angle;
+}
+
+void Simulation::stickCurrentKnife(float angle) {
+    // Place it at the current rotation; the angle already accounts for contact time
+    currentKnife.stickAtAngle(angle, target.getX(), target.getY(), target.getRotation());
+    target.addStuckKnife(angle, GameConstants::TARGET_RADIUS);
+}
+
+bool Simulation::checkKnifeCollision(float incomingX, float incomingY) const {
+    // Calculate incoming knife's angle relative to target
+    float incomingAngle = atan2(incomingY - target.getY(), incomingX - target.getX()) * 180.0f / M_PI;
+    KH_LOG_DEBUG("Incoming knife pos: (%.1f, %.1f), angle: %.2f deg (absolute)",
+        incomingX, incomingY, incomingAngle);
+
+    // Normalize the angle relative to target's current rotation
+    incomingAngle -= target.getRotation();
+    if (incomingAngle < 0) incomingAngle += 360;
+    if (incomingAngle >= 360) incomingAngle -= 360;
+
+    return checkSweptCollision(incomingAngle, incomingAngle);
+}
+
+bool Simulation::checkSweptCollision(float startAngle, float endAngle) const {
+    if (target.getObstacleCount() == 0) {
+        KH_LOG_DEBUG("No stuck knives to check collision against");
+        return false;
+    }
+
+    KH_LOG_DEBUG("=== COLLISION CHECK START === obstacles: %zu, threshold: %.1fpx, sweep: %.2f -> %.2f deg",
+        target.getObstacleCount(), GameConstants::SPATIAL_COLLISION_THRESHOLD, startAngle, endAngle);
+
+    // Handles collide when their arc separation at the handle radius is under the
+    // threshold, so the blocked region is a fixed angular half-width either side
+    float handleRadius = GameConstants::TARGET_RADIUS + GameConstants::KNIFE_IMAGE_HANDLE_OFFSET;
+    float halfWidth = (GameConstants::SPATIAL_COLLISION_THRESHOLD / handleRadius) * 180.0f / M_PI;
+
+    // Widen the query by the arc the target turned through during the sweep
+    float sweep = endAngle - startAngle;
+    if (sweep > 180) sweep -= 360;
+    if (sweep < -180) sweep += 360;
+    float center = startAngle + sweep / 2;
+    if (center < 0) center += 360;
+    if (center >= 360) center -= 360;
+
+    if (target.isArcOccupied(center, halfWidth + std::abs(sweep) / 2)) {
+        KH_LOG_DEBUG("=== COLLISION CHECK END (COLLISION FOUND) ===");
+        return true;
+    }
+
+    KH_LOG_DEBUG("=== COLLISION CHECK END (NO COLLISION) ===");
+    return false;
+}
+
+void Simulation::updateStuckKnives() {
+    // Update all stuck knives to rotate with the target
+    target.updateStuckKnives();
+}
+
+void Simulation::placeStuckKnife(float angle) {
+    target.addStuckKnife(angle, GameConstants::TARGET_RADIUS);
+}
+
+void Simulation::throwKnife() {
+    if (!canThrow || knivesLeft <= 0) return;  // Safety check
+
+    currentKnife.setVelocityY(-GameConstants::KNIFE_SPEED);
+    currentKnife.setActive(true);
+    canThrow = false;
+    knivesLeft--;
+}
+
+void Simulation::initializeLevel() {
+    target.reset(level, rng);
+    currentKnife = Knife(); // Reset knife to starting position
+    knivesLeft = GameConstants::KNIVES_PER_LEVEL;  // Target::reset placed any pre-stuck knives
+    canThrow = true;
+
+    // NEW: Reset collision state
+    collisionDetected = false;
+    collisionPauseTimer = 0.0f;
+
+    // FIXED: Ensure knife is properly positioned and visible
+    currentKnife.reset(); // Make sure knife is at starting position
+    currentKnife.setActive(true); // Make sure knife is active and visible
+}
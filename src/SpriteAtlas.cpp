@@ -0,0 +1,351 @@
+#include "../include/SpriteAtlas.hpp"
+#include "../include/AssetArchive.hpp"
+#include "../include/AssetLoader.hpp"
+#include "../include/GameConstants.hpp"
+#include "../include/Logger.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    struct SpriteSource {
+        SpriteId id;
+        const char* path;  // nullptr for sprites that are always generated
+        float width;   // Size the sprite is drawn at
+        float height;
+    };
+
+    const SpriteSource SPRITE_SOURCES[] = {
+        { SpriteId::BACKGROUND, "assets/images/background.bmp",
+            static_cast<float>(GameConstants::SCREEN_WIDTH), static_cast<float>(GameConstants::SCREEN_HEIGHT) },
+        { SpriteId::TARGET, "assets/images/target.bmp",
+            GameConstants::TARGET_RADIUS * 2.0f, GameConstants::TARGET_RADIUS * 2.0f },
+        { SpriteId::KNIFE, "assets/images/knife.bmp",
+            GameConstants::KNIFE_WIDTH, GameConstants::KNIFE_LENGTH },
+        { SpriteId::BULLSEYE, "assets/images/bullseye.bmp",
+            GameConstants::BULLSEYE_RADIUS * 2.0f, GameConstants::BULLSEYE_RADIUS * 2.0f },
+        { SpriteId::PARTICLE, nullptr, 16.0f, 16.0f },
+    };
+
+    // Halve with bilinear filtering until within 2x of the final size, then
+    // do the last step; a single bilinear step from 1244px to 80px would alias
+    SDL_Surface* scaleToSize(SDL_Surface* source, int width, int height) {
+        SDL_Surface* current = source;
+        while (current->w / 2 >= width && current->h / 2 >= height) {
+            SDL_Surface* half = SDL_ScaleSurface(current, current->w / 2, current->h / 2, SDL_SCALEMODE_LINEAR);
+            if (current != source) SDL_DestroySurface(current);
+            if (!half) return nullptr;
+            current = half;
+        }
+
+        SDL_Surface* scaled = SDL_ScaleSurface(current, width, height, SDL_SCALEMODE_LINEAR);
+        if (current != source) SDL_DestroySurface(current);
+        return scaled;
+    }
+
+    Uint32 packColor(const GameConstants::Colors::Color& color) {
+        return (static_cast<Uint32>(color.a) << 24) | (static_cast<Uint32>(color.r) << 16) |
+            (static_cast<Uint32>(color.g) << 8) | color.b;
+    }
+
+    // Source-over blend of color at the given coverage onto an ARGB pixel
+    Uint32 blendOver(Uint32 destination, const GameConstants::Colors::Color& color, float coverage) {
+        float srcA = color.a / 255.0f * coverage;
+        float dstA = (destination >> 24) / 255.0f;
+        float outA = srcA + dstA * (1.0f - srcA);
+        if (outA <= 0.0f) return 0;
+
+        auto channel = [&](Uint32 src, int shift) {
+            float dst = static_cast<float>((destination >> shift) & 0xFF);
+            return static_cast<Uint32>((src * srcA + dst * dstA * (1.0f - srcA)) / outA + 0.5f) << shift;
+        };
+        return (static_cast<Uint32>(outA * 255.0f + 0.5f) << 24) |
+            channel(color.r, 16) | channel(color.g, 8) | channel(color.b, 0);
+    }
+
+    Uint32* rowPointer(SDL_Surface* surface, int y) {
+        return reinterpret_cast<Uint32*>(static_cast<Uint8*>(surface->pixels) + y * surface->pitch);
+    }
+
+    // Filled disc, one solid span per row with anti-aliased end pixels. The
+    // span fill is a plain store loop the compiler vectorizes.
+    void fillDisc(SDL_Surface* surface, float centerX, float centerY, float radius,
+        const GameConstants::Colors::Color& color) {
+        const Uint32 solid = packColor(color);
+        for (int y = 0; y < surface->h; y++) {
+            float dy = y + 0.5f - centerY;
+            if (std::fabs(dy) >= radius) continue;
+
+            float halfSpan = std::sqrt(radius * radius - dy * dy);
+            float left = centerX - halfSpan;
+            float right = centerX + halfSpan;
+            int first = std::max(0, static_cast<int>(std::ceil(left)));
+            int last = std::min(surface->w, static_cast<int>(std::floor(right)));
+
+            Uint32* row = rowPointer(surface, y);
+            if (last > first) std::fill(row + first, row + last, solid);
+
+            // Partial coverage at the two edge pixels
+            int leftEdge = first - 1;
+            if (leftEdge >= 0) row[leftEdge] = blendOver(row[leftEdge], color, first - left);
+            if (last < surface->w && last >= first) row[last] = blendOver(row[last], color, right - last);
+        }
+    }
+
+    // Thin circle outline, by distance from the center
+    void strokeCircle(SDL_Surface* surface, float centerX, float centerY, float radius, float width,
+        const GameConstants::Colors::Color& color) {
+        int top = std::max(0, static_cast<int>(centerY - radius - width));
+        int bottom = std::min(surface->h, static_cast<int>(centerY + radius + width) + 1);
+        for (int y = top; y < bottom; y++) {
+            Uint32* row = rowPointer(surface, y);
+            float dy = y + 0.5f - centerY;
+            for (int x = 0; x < surface->w; x++) {
+                float dx = x + 0.5f - centerX;
+                float coverage = width / 2 - std::fabs(std::sqrt(dx * dx + dy * dy) - radius) + 0.5f;
+                if (coverage > 0.0f) {
+                    row[x] = blendOver(row[x], color, std::min(coverage, 1.0f));
+                }
+            }
+        }
+    }
+
+    // Procedural stand-ins for sprites whose image is missing, drawn once
+    // into the atlas so they cost the same per frame as the real images
+    SDL_Surface* generateFallback(SpriteId id, int width, int height) {
+        using namespace GameConstants::Colors;
+
+        SDL_Surface* surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_ARGB8888);
+        if (!surface) return nullptr;
+        SDL_FillSurfaceRect(surface, nullptr, 0);
+
+        float centerX = width / 2.0f;
+        float centerY = height / 2.0f;
+        float radius = std::min(width, height) / 2.0f;
+
+        switch (id) {
+        case SpriteId::BACKGROUND:
+            // Vertical teal gradient
+            for (int y = 0; y < height; y++) {
+                float t = static_cast<float>(y) / height;
+                Color color(
+                    static_cast<unsigned char>(BACKGROUND_TOP.r * (1 - t) + BACKGROUND_BOTTOM.r * t),
+                    static_cast<unsigned char>(BACKGROUND_TOP.g * (1 - t) + BACKGROUND_BOTTOM.g * t),
+                    static_cast<unsigned char>(BACKGROUND_TOP.b * (1 - t) + BACKGROUND_BOTTOM.b * t));
+                Uint32* row = rowPointer(surface, y);
+                std::fill(row, row + width, packColor(color));
+            }
+            break;
+
+        case SpriteId::TARGET: {
+            // Ring spacing follows the output scale so the disc looks the same at any size
+            float unit = radius / GameConstants::TARGET_RADIUS;
+            fillDisc(surface, centerX, centerY, radius, WOOD);
+            for (float ring = 20.0f * unit; ring < radius; ring += 20.0f * unit) {
+                strokeCircle(surface, centerX, centerY, ring, 1.5f * unit, WOOD_DARK);
+            }
+            break;
+        }
+
+        case SpriteId::KNIFE: {
+            // Blade on top (the tip leads), handle below
+            int bladeEnd = height * 2 / 3;
+            for (int y = 0; y < height; y++) {
+                Uint32* row = rowPointer(surface, y);
+                std::fill(row, row + width, packColor(y < bladeEnd ? KNIFE_BLADE : KNIFE_HANDLE));
+            }
+            break;
+        }
+
+        case SpriteId::BULLSEYE:
+            fillDisc(surface, centerX, centerY, radius, RED);
+            fillDisc(surface, centerX, centerY, radius / 2.0f, WHITE);
+            break;
+
+        case SpriteId::PARTICLE:
+            fillDisc(surface, centerX, centerY, radius - 1.0f, WHITE);
+            break;
+
+        default:
+            break;
+        }
+        return surface;
+    }
+}
+
+SpriteAtlas::SpriteAtlas()
+    : sources()
+    , surface(nullptr)
+    , texture(nullptr)
+    , scale(1.0f)
+    , regions() {
+}
+
+SpriteAtlas::~SpriteAtlas() {
+    destroyTexture();
+    if (surface) {
+        SDL_DestroySurface(surface);
+    }
+    for (SDL_Surface* source : sources) {
+        if (source) SDL_DestroySurface(source);
+    }
+}
+
+void SpriteAtlas::load(const AssetArchive* archive) {
+    for (const SpriteSource& source : SPRITE_SOURCES) {
+        SDL_Surface*& decoded = sources[static_cast<size_t>(source.id)];
+        if (decoded || !source.path) continue;
+        decoded = decodeImage(source.id, archive);
+    }
+}
+
+void SpriteAtlas::loadAsync(AssetLoader& loader, const AssetArchive* archive) {
+    // Each job fills only its own slot in sources
+    for (const SpriteSource& source : SPRITE_SOURCES) {
+        SDL_Surface** decoded = &sources[static_cast<size_t>(source.id)];
+        if (*decoded || !source.path) continue;
+        SpriteId id = source.id;
+        loader.submit([decoded, id, archive]() { *decoded = decodeImage(id, archive); });
+    }
+}
+
+SDL_Surface* SpriteAtlas::decodeImage(SpriteId id, const AssetArchive* archive) {
+    const char* path = getSourcePath(id);
+    SDL_Surface* decoded = nullptr;
+
+    const AssetEntry* packed = archive ? archive->find(path) : nullptr;
+    if (packed && packed->type == AssetType::IMAGE) {
+        // Already decoded by the packer; the surface reads the mapping in place
+        decoded = SDL_CreateSurfaceFrom(packed->width, packed->height,
+            static_cast<SDL_PixelFormat>(packed->pixelFormat), const_cast<void*>(packed->data), packed->pitch);
+    }
+    else {
+        SDL_Surface* loaded = SDL_LoadBMP(path);
+        if (loaded) {
+            decoded = SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_ARGB8888);
+            SDL_DestroySurface(loaded);
+        }
+    }
+
+    // A missing image is not fatal: build() draws a procedural one in its place
+    if (!decoded) {
+        KH_LOG_WARN("Failed to load %s image, using generated fallback: %s", getSpriteName(id), SDL_GetError());
+    }
+    return decoded;
+}
+
+bool SpriteAtlas::build(float outputScale) {
+    std::array<SDL_Surface*, static_cast<size_t>(SpriteId::COUNT)> images = {};
+    scale = outputScale;
+
+    for (const SpriteSource& source : SPRITE_SOURCES) {
+        // Round up so a sprite never ends up with fewer texels than pixels it covers
+        int width = static_cast<int>(std::ceil(source.width * scale));
+        int height = static_cast<int>(std::ceil(source.height * scale));
+
+        SDL_Surface* decoded = sources[static_cast<size_t>(source.id)];
+        SDL_Surface* scaled = decoded ? scaleToSize(decoded, width, height) : nullptr;
+        if (!scaled) {
+            scaled = generateFallback(source.id, width, height);
+        }
+        images[static_cast<size_t>(source.id)] = scaled;
+    }
+
+    int atlasWidth = ATLAS_WIDTH;
+    for (SDL_Surface* image : images) {
+        if (image) atlasWidth = std::max(atlasWidth, image->w + 2 * PADDING);
+    }
+
+    // Shelf packing, tallest first, so each shelf is as tall as its first sprite
+    std::array<size_t, static_cast<size_t>(SpriteId::COUNT)> order;
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&images](size_t a, size_t b) {
+        int heightA = images[a] ? images[a]->h : 0;
+        int heightB = images[b] ? images[b]->h : 0;
+        return heightA > heightB;
+    });
+
+    int penX = PADDING;
+    int penY = PADDING;
+    int shelfHeight = 0;
+    for (size_t i : order) {
+        regions[i] = SpriteRegion();
+        if (!images[i]) continue;
+
+        if (penX + images[i]->w + PADDING > atlasWidth) {
+            penX = PADDING;
+            penY += shelfHeight + PADDING;
+            shelfHeight = 0;
+        }
+        regions[i].pixels = { static_cast<float>(penX), static_cast<float>(penY),
+            static_cast<float>(images[i]->w), static_cast<float>(images[i]->h) };
+        penX += images[i]->w + PADDING;
+        shelfHeight = std::max(shelfHeight, images[i]->h);
+    }
+    int atlasHeight = penY + shelfHeight + PADDING;
+
+    if (surface) SDL_DestroySurface(surface);
+    surface = SDL_CreateSurface(atlasWidth, atlasHeight, SDL_PIXELFORMAT_ARGB8888);
+    if (surface) {
+        SDL_FillSurfaceRect(surface, nullptr, 0);
+    }
+    else {
+        KH_LOG_ERROR("Failed to create sprite atlas surface: %s", SDL_GetError());
+    }
+
+    for (size_t i = 0; i < images.size(); i++) {
+        if (!images[i]) continue;
+        if (surface) {
+            SDL_SetSurfaceBlendMode(images[i], SDL_BLENDMODE_NONE);
+            SDL_Rect dest = { static_cast<int>(regions[i].pixels.x), static_cast<int>(regions[i].pixels.y),
+                images[i]->w, images[i]->h };
+            SDL_BlitSurface(images[i], nullptr, surface, &dest);
+
+            const SDL_FRect& pixels = regions[i].pixels;
+            regions[i].uv = { pixels.x / atlasWidth, pixels.y / atlasHeight,
+                pixels.w / atlasWidth, pixels.h / atlasHeight };
+        }
+        SDL_DestroySurface(images[i]);
+    }
+
+    if (!surface) return false;
+    KH_LOG_INFO("Sprite atlas: %dx%d at %.2fx", atlasWidth, atlasHeight, scale);
+    return true;
+}
+
+bool SpriteAtlas::createTexture(SDL_Renderer* renderer) {
+    destroyTexture();
+    if (!surface) return false;
+
+    texture = SDL_CreateTextureFromSurface(renderer, surface);
+    if (!texture) {
+        KH_LOG_ERROR("Failed to create sprite atlas texture: %s", SDL_GetError());
+        return false;
+    }
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return true;
+}
+
+void SpriteAtlas::destroyTexture() {
+    if (texture) {
+        SDL_DestroyTexture(texture);
+        texture = nullptr;
+    }
+}
+
+const char* SpriteAtlas::getSourcePath(SpriteId id) {
+    for (const SpriteSource& source : SPRITE_SOURCES) {
+        if (source.id == id) return source.path;
+    }
+    return nullptr;
+}
+
+const char* SpriteAtlas::getSpriteName(SpriteId id) {
+    switch (id) {
+    case SpriteId::BACKGROUND: return "background";
+    case SpriteId::TARGET: return "target";
+    case SpriteId::KNIFE: return "knife";
+    case SpriteId::BULLSEYE: return "bullseye";
+    case SpriteId::PARTICLE: return "particle";
+    default: return "unknown";
+    }
+}
@@ -0,0 +1,55 @@
+#include "../include/SpriteBatch.hpp"
+#include <cmath>
+
+namespace {
+    const SDL_FColor WHITE = { 1.0f, 1.0f, 1.0f, 1.0f };
+}
+
+SpriteBatch::SpriteBatch()
+    : texture(nullptr) {
+}
+
+void SpriteBatch::begin(SDL_Texture* batchTexture) {
+    texture = batchTexture;
+    vertices.clear();
+    indices.clear();
+}
+
+void SpriteBatch::add(float centerX, float centerY, float width, float height, float rotation, const SDL_FRect& uv) {
+    if (rotation == 0.0f) {
+        add(centerX, centerY, width, height, 1.0f, 0.0f, uv);
+        return;
+    }
+    float radians = rotation * static_cast<float>(M_PI) / 180.0f;
+    add(centerX, centerY, width, height, std::cos(radians), std::sin(radians), uv);
+}
+
+void SpriteBatch::add(float centerX, float centerY, float width, float height, float cosRotation, float sinRotation,
+    const SDL_FRect& uv) {
+    add(centerX, centerY, width, height, cosRotation, sinRotation, uv, WHITE);
+}
+
+void SpriteBatch::add(float centerX, float centerY, float width, float height, float cosRotation, float sinRotation,
+    const SDL_FRect& uv, const SDL_FColor& color) {
+    // Half-extent axes after rotation; the corners are center +/- these
+    float axisXx = cosRotation * width / 2, axisXy = sinRotation * width / 2;
+    float axisYx = -sinRotation * height / 2, axisYy = cosRotation * height / 2;
+
+    int base = static_cast<int>(vertices.size());
+    vertices.push_back({ { centerX - axisXx - axisYx, centerY - axisXy - axisYy }, color, { uv.x, uv.y } });
+    vertices.push_back({ { centerX + axisXx - axisYx, centerY + axisXy - axisYy }, color, { uv.x + uv.w, uv.y } });
+    vertices.push_back({ { centerX + axisXx + axisYx, centerY + axisXy + axisYy }, color, { uv.x + uv.w, uv.y + uv.h } });
+    vertices.push_back({ { centerX - axisXx + axisYx, centerY - axisXy + axisYy }, color, { uv.x, uv.y + uv.h } });
+
+    const int quad[] = { base, base + 1, base + 2, base, base + 2, base + 3 };
+    indices.insert(indices.end(), quad, quad + 6);
+}
+
+void SpriteBatch::flush(SDL_Renderer* renderer) {
+    if (!indices.empty()) {
+        SDL_RenderGeometry(renderer, texture, vertices.data(), static_cast<int>(vertices.size()),
+            indices.data(), static_cast<int>(indices.size()));
+    }
+    vertices.clear();
+    indices.clear();
+}
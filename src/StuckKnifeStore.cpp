@@ -0,0 +1,120 @@
+#include "../include/StuckKnifeStore.hpp"
+#include "../include/GameConstants.hpp"
+#include <cmath>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define KNIFEHIT_STUCK_KNIVES_AVX 1
+#elif defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#include <xmmintrin.h>
+#define KNIFEHIT_STUCK_KNIVES_SSE 1
+#endif
+
+namespace {
+    const float DEG_TO_RAD = static_cast<float>(M_PI) / 180.0f;
+
+    // Stuck knives sit with the tip buried in the rim, and sprites point outward
+    const float TIP_OFFSET = GameConstants::KNIFE_IMAGE_TIP_OFFSET;
+    const float SPRITE_ROTATION_OFFSET = -90.0f;
+}
+
+void StuckKnifeStore::add(float angle, float distance, float targetX, float targetY, float targetRotation) {
+    angles.push_back(angle);
+    distances.push_back(distance);
+    cosAngles.push_back(std::cos(angle * DEG_TO_RAD));
+    sinAngles.push_back(std::sin(angle * DEG_TO_RAD));
+    directionXs.push_back(0.0f);
+    directionYs.push_back(0.0f);
+    xs.push_back(0.0f);
+    ys.push_back(0.0f);
+    rotations.push_back(0.0f);
+
+    float rotationRad = targetRotation * DEG_TO_RAD;
+    updateRange(angles.size() - 1, angles.size(), targetX, targetY,
+        std::cos(rotationRad), std::sin(rotationRad), targetRotation + SPRITE_ROTATION_OFFSET);
+}
+
+void StuckKnifeStore::clear() {
+    angles.clear();
+    distances.clear();
+    cosAngles.clear();
+    sinAngles.clear();
+    directionXs.clear();
+    directionYs.clear();
+    xs.clear();
+    ys.clear();
+    rotations.clear();
+}
+
+void StuckKnifeStore::update(float targetX, float targetY, float targetRotation) {
+    const size_t count = angles.size();
+    const float rotationRad = targetRotation * DEG_TO_RAD;
+    const float cosRotation = std::cos(rotationRad);
+    const float sinRotation = std::sin(rotationRad);
+    const float rotationOffset = targetRotation + SPRITE_ROTATION_OFFSET;
+
+    // Angle addition: cos(a + r) = cos a cos r - sin a sin r,
+    //                 sin(a + r) = sin a cos r + cos a sin r
+    size_t i = 0;
+#if defined(KNIFEHIT_STUCK_KNIVES_AVX)
+    const __m256 cx = _mm256_set1_ps(targetX);
+    const __m256 cy = _mm256_set1_ps(targetY);
+    const __m256 cr = _mm256_set1_ps(cosRotation);
+    const __m256 sr = _mm256_set1_ps(sinRotation);
+    const __m256 tip = _mm256_set1_ps(TIP_OFFSET);
+    const __m256 offset = _mm256_set1_ps(rotationOffset);
+    for (; i + 8 <= count; i += 8) {
+        __m256 ca = _mm256_loadu_ps(&cosAngles[i]);
+        __m256 sa = _mm256_loadu_ps(&sinAngles[i]);
+        __m256 r = _mm256_sub_ps(_mm256_loadu_ps(&distances[i]), tip);
+        __m256 c = _mm256_sub_ps(_mm256_mul_ps(ca, cr), _mm256_mul_ps(sa, sr));
+        __m256 s = _mm256_add_ps(_mm256_mul_ps(sa, cr), _mm256_mul_ps(ca, sr));
+        _mm256_storeu_ps(&directionXs[i], c);
+        _mm256_storeu_ps(&directionYs[i], s);
+        _mm256_storeu_ps(&xs[i], _mm256_add_ps(cx, _mm256_mul_ps(r, c)));
+        _mm256_storeu_ps(&ys[i], _mm256_add_ps(cy, _mm256_mul_ps(r, s)));
+        _mm256_storeu_ps(&rotations[i], _mm256_add_ps(_mm256_loadu_ps(&angles[i]), offset));
+    }
+#elif defined(KNIFEHIT_STUCK_KNIVES_SSE)
+    const __m128 cx = _mm_set1_ps(targetX);
+    const __m128 cy = _mm_set1_ps(targetY);
+    const __m128 cr = _mm_set1_ps(cosRotation);
+    const __m128 sr = _mm_set1_ps(sinRotation);
+    const __m128 tip = _mm_set1_ps(TIP_OFFSET);
+    const __m128 offset = _mm_set1_ps(rotationOffset);
+    for (; i + 4 <= count; i += 4) {
+        __m128 ca = _mm_loadu_ps(&cosAngles[i]);
+        __m128 sa = _mm_loadu_ps(&sinAngles[i]);
+        __m128 r = _mm_sub_ps(_mm_loadu_ps(&distances[i]), tip);
+        __m128 c = _mm_sub_ps(_mm_mul_ps(ca, cr), _mm_mul_ps(sa, sr));
+        __m128 s = _mm_add_ps(_mm_mul_ps(sa, cr), _mm_mul_ps(ca, sr));
+        _mm_storeu_ps(&directionXs[i], c);
+        _mm_storeu_ps(&directionYs[i], s);
+        _mm_storeu_ps(&xs[i], _mm_add_ps(cx, _mm_mul_ps(r, c)));
+        _mm_storeu_ps(&ys[i], _mm_add_ps(cy, _mm_mul_ps(r, s)));
+        _mm_storeu_ps(&rotations[i], _mm_add_ps(_mm_loadu_ps(&angles[i]), offset));
+    }
+#endif
+    // Remainder (or everything, without SIMD)
+    updateRange(i, count, targetX, targetY, cosRotation, sinRotation, rotationOffset);
+}
+
+void StuckKnifeStore::updateScalar(float targetX, float targetY, float targetRotation) {
+    const float rotationRad = targetRotation * DEG_TO_RAD;
+    updateRange(0, angles.size(), targetX, targetY,
+        std::cos(rotationRad), std::sin(rotationRad), targetRotation + SPRITE_ROTATION_OFFSET);
+}
+
+void StuckKnifeStore::updateRange(size_t begin, size_t end, float targetX, float targetY,
+    float cosRotation, float sinRotation, float rotationOffset) {
+    for (size_t i = begin; i < end; i++) {
+        float r = distances[i] - TIP_OFFSET;
+        float c = cosAngles[i] * cosRotation - sinAngles[i] * sinRotation;
+        float s = sinAngles[i] * cosRotation + cosAngles[i] * sinRotation;
+        directionXs[i] = c;
+        directionYs[i] = s;
+        xs[i] = targetX + r * c;
+        ys[i] = targetY + r * s;
+        rotations[i] = angles[i] + rotationOffset;
+    }
+}
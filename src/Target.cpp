@@ -1,50 +1,87 @@
 #include "../include/Target.hpp"
-#include <random>
+#include <algorithm>
 
 Target::Target()
     : x(GameConstants::TARGET_X)
     , y(GameConstants::TARGET_Y)
     , radius(GameConstants::TARGET_RADIUS)
     , rotation(0)
+    , previousRotation(0)
     , rotationSpeed(GameConstants::BASE_ROTATION_SPEED) {
 }
 
 void Target::update(float deltaTime) {
+    previousRotation = rotation;
     rotation += rotationSpeed * deltaTime;
     if (rotation >= 360) rotation -= 360;
     if (rotation < 0) rotation += 360;
 }
 
-void Target::reset(int level) {
+void Target::reset(int level, std::mt19937& rng) {
     rotation = 0;
+    previousRotation = 0;
     rotationSpeed = GameConstants::BASE_ROTATION_SPEED + (level * GameConstants::ROTATION_SPEED_INCREMENT);
 
     if (level > GameConstants::LEVEL_FOR_REVERSE_ROTATION) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_int_distribution<> dis(0, 1);
-        rotationSpeed *= (dis(gen) == 0) ? 1 : -1; // Random direction
+        rotationSpeed *= (dis(rng) == 0) ? 1 : -1; // Random direction
     }
 
-    stuckKnifeAngles.clear();
-    stuckKnifeDistances.clear();
+    stuckKnives.clear();
+    sortedAngles.clear();
 
     // Add some pre-stuck knives for higher levels
     if (level > 1) {
-        std::random_device rd;
-        std::mt19937 gen(rd());
         std::uniform_real_distribution<float> angleDist(0, 360);
 
         int preStuckKnives = std::min(level - 1, GameConstants::MAX_PRE_STUCK_KNIVES);
         for (int i = 0; i < preStuckKnives; i++) {
-            float angle = angleDist(gen);
-            stuckKnifeAngles.push_back(angle);
-            stuckKnifeDistances.push_back(GameConstants::KNIFE_TARGET_HIT_THRESHOLD);
+            addStuckKnife(angleDist(rng), GameConstants::TARGET_RADIUS);
         }
     }
 }
 
+float Target::getInterpolatedRotation(float alpha) const {
+    // Take the short way around when the rotation wrapped during the tick
+    float delta = rotation - previousRotation;
+    if (delta > 180) delta -= 360;
+    if (delta < -180) delta += 360;
+
+    float interpolated = previousRotation + delta * alpha;
+    if (interpolated >= 360) interpolated -= 360;
+    if (interpolated < 0) interpolated += 360;
+    return interpolated;
+}
+
 void Target::addStuckKnife(float angle, float distance) {
-    stuckKnifeAngles.push_back(angle);
-    stuckKnifeDistances.push_back(distance);
-} 
\ No newline at end of file
+    stuckKnives.add(angle, distance, x, y, rotation);
+
+    if (angle >= 360) angle -= 360;
+    if (angle < 0) angle += 360;
+    sortedAngles.insert(std::upper_bound(sortedAngles.begin(), sortedAngles.end(), angle), angle);
+}
+
+void Target::updateStuckKnives() {
+    stuckKnives.update(x, y, rotation);
+}
+
+bool Target::isArcOccupied(float angle, float halfWidth) const {
+    float low = angle - halfWidth;
+    float high = angle + halfWidth;
+
+    // Split arcs that wrap past 0/360 into two plain ranges; the low end of
+    // the wrapped half is -1 so an obstacle exactly at 0 is included
+    if (low < 0) {
+        return hasAngleBetween(low + 360, 360) || hasAngleBetween(-1, high);
+    }
+    if (high >= 360) {
+        return hasAngleBetween(low, 360) || hasAngleBetween(-1, high - 360);
+    }
+    return hasAngleBetween(low, high);
+}
+
+bool Target::hasAngleBetween(float low, float high) const {
+    // Open interval, matching the strict "closer than threshold" collision rule
+    auto it = std::upper_bound(sortedAngles.begin(), sortedAngles.end(), low);
+    return it != sortedAngles.end() && *it < high;
+}
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "../include/TextCache.hpp"
+#include "../include/Logger.hpp"
+
+TextCache::TextCache(size_t maxEntries, size_t maxBytes)
+    : maxEntries(maxEntries)
+    , maxBytes(maxBytes)
+    , stats() {
+}
+
+TextCache::~TextCache() {
+    clear();
+}
+
+const TextTexture* TextCache::get(SDL_Renderer* renderer, TTF_Font* font, int fontId,
+    const std::string& text, const SDL_Color& color) {
+    // Key: font id bytes, text, NUL, then the RGB bytes
+    scratchKey.assign(reinterpret_cast<const char*>(&fontId), sizeof(fontId));
+    scratchKey.append(text);
+    scratchKey.push_back('\0');
+    scratchKey.push_back(static_cast<char>(color.r));
+    scratchKey.push_back(static_cast<char>(color.g));
+    scratchKey.push_back(static_cast<char>(color.b));
+
+    auto found = index.find(scratchKey);
+    if (found != index.end()) {
+        stats.hits++;
+        entries.splice(entries.begin(), entries, found->second);
+        return &found->second->text;
+    }
+    stats.misses++;
+
+#ifdef KNIFEHIT_NO_TTF
+    (void)renderer;
+    (void)font;
+    return nullptr;
+#else
+    SDL_Color opaque = { color.r, color.g, color.b, 255 };
+    SDL_Surface* surface = TTF_RenderText_Blended(font, text.c_str(), text.length(), opaque);
+    if (!surface) {
+        KH_LOG_ERROR("Failed to create text surface");
+        return nullptr;
+    }
+
+    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, surface);
+    TextTexture result = { texture, surface->w, surface->h };
+    SDL_DestroySurface(surface);
+    if (!texture) {
+        KH_LOG_ERROR("Failed to create text texture: %s", SDL_GetError());
+        return nullptr;
+    }
+
+    entries.push_front({ scratchKey, result });
+    index.emplace(scratchKey, entries.begin());
+    stats.entries++;
+    stats.bytes += static_cast<size_t>(result.width) * result.height * 4;
+
+    // Never evict the entry just added, even if it alone exceeds the budget
+    while (stats.entries > 1 && (stats.entries > maxEntries || stats.bytes > maxBytes)) {
+        evict();
+    }
+    return &entries.front().text;
+#endif
+}
+
+void TextCache::clear() {
+    for (auto& entry : entries) {
+        SDL_DestroyTexture(entry.text.texture);
+    }
+    entries.clear();
+    index.clear();
+    stats.entries = 0;
+    stats.bytes = 0;
+}
+
+void TextCache::evict() {
+    Entry& oldest = entries.back();
+    stats.bytes -= static_cast<size_t>(oldest.text.width) * oldest.text.height * 4;
+    stats.entries--;
+    stats.evictions++;
+
+    SDL_DestroyTexture(oldest.text.texture);
+    index.erase(oldest.key);
+    entries.pop_back();
+}
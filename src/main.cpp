@@ -1,9 +1,53 @@
 #include "../include/Game.hpp"
+#include "../include/HeadlessRunner.hpp"
+#include <cstdlib>
+#include <cstring>
 
 int main(int argc, char* argv[]) {
+    bool headless = false;
+    HeadlessOptions headlessOptions;
+    GameOptions gameOptions;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+        else if (strcmp(argv[i], "--ticks") == 0 && i + 1 < argc) {
+            headlessOptions.ticks = atoll(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--throw-interval") == 0 && i + 1 < argc) {
+            headlessOptions.throwInterval = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            headlessOptions.hasSeed = true;
+            headlessOptions.seed = static_cast<unsigned int>(strtoul(argv[++i], nullptr, 10));
+        }
+        else if (strcmp(argv[i], "--record") == 0 && i + 1 < argc) {
+            headlessOptions.recordPath = gameOptions.recordPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc) {
+            headlessOptions.replayPath = gameOptions.replayPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            gameOptions.targetFps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--assets") == 0 && i + 1 < argc) {
+            gameOptions.assetPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--render-scale") == 0 && i + 1 < argc) {
+            gameOptions.renderScale = static_cast<float>(atof(argv[++i]));
+        }
+    }
+
+    // Headless mode never touches SDL video, so it runs on display-less machines
+    if (headless) {
+        HeadlessRunner runner(headlessOptions);
+        return runner.run();
+    }
+
     Game game;
     
-    if (!game.initialize()) {
+    if (!game.initialize(gameOptions)) {
         return 1;
     }
 
@@ -0,0 +1,55 @@
+#include "../include/FontManager.hpp"
+#include "../include/GlyphAtlas.hpp"
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Rasterizes the glyph atlas of every built-in font style and saves it as a
+// baked sheet (metrics, kerning and coverage), so the game draws text
+// without starting FreeType. Sheets go to --out-dir, by default the
+// directory FontManager looks in. Run from the repository root so the font
+// paths resolve.
+
+int main(int argc, char* argv[]) {
+    std::string outDir = FontManager::getBakedDirectory();
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out-dir") == 0 && i + 1 < argc) {
+            outDir = argv[++i];
+        }
+    }
+    SDL_CreateDirectory(outDir.c_str());
+
+    if (!TTF_Init()) {
+        std::cerr << "TTF_Init failed: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    bool complete = true;
+    for (const auto& style : FontManager::getBuiltInStyles()) {
+        std::string facePath = FontManager::getFacePath(style.first);
+        std::string bakedPath = outDir + "/" + FontManager::getBakedName(style.first, style.second);
+
+        TTF_Font* font = TTF_OpenFont(facePath.c_str(), static_cast<float>(style.second));
+        if (!font) {
+            std::cerr << "Can't open " << facePath << ": " << SDL_GetError() << std::endl;
+            complete = false;
+            continue;
+        }
+
+        GlyphAtlas atlas;
+        if (!atlas.build(font) || !atlas.saveBaked(bakedPath)) {
+            std::cerr << "Failed to bake " << facePath << " at " << style.second << " px" << std::endl;
+            complete = false;
+        }
+        else {
+            std::cout << "  " << bakedPath << std::endl;
+        }
+        TTF_CloseFont(font);
+    }
+
+    TTF_Quit();
+    SDL_Quit();
+    return complete ? 0 : 1;
+}
@@ -0,0 +1,101 @@
+#include "../include/AssetArchive.hpp"
+#include "../include/SpriteAtlas.hpp"
+#include "../include/FontManager.hpp"
+#include <SDL3/SDL.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+// Writes the asset archive the game maps at startup: every sprite image
+// decoded to ARGB8888 rows, plus the font files and baked font sheets
+// FontManager loads. Only assets the game references are packed. Sheets are
+// read from --baked-dir, by default where bake_fonts writes them. Run from
+// the repository root so the asset paths resolve.
+
+namespace {
+    bool packImage(const char* path, std::vector<PackedAsset>& assets) {
+        SDL_Surface* loaded = SDL_LoadBMP(path);
+        SDL_Surface* converted = loaded ? SDL_ConvertSurface(loaded, SDL_PIXELFORMAT_ARGB8888) : nullptr;
+        if (loaded) SDL_DestroySurface(loaded);
+        if (!converted) {
+            std::cerr << "Skipping " << path << ": " << SDL_GetError() << std::endl;
+            return false;
+        }
+
+        // Tightly packed rows, so the game can hand the bytes to SDL as they are
+        PackedAsset asset;
+        asset.name = path;
+        asset.info = { AssetType::IMAGE, nullptr, 0, SDL_PIXELFORMAT_ARGB8888,
+            converted->w, converted->h, converted->w * 4 };
+        asset.bytes.resize(static_cast<size_t>(asset.info.pitch) * converted->h);
+        for (int y = 0; y < converted->h; y++) {
+            memcpy(asset.bytes.data() + static_cast<size_t>(y) * asset.info.pitch,
+                static_cast<const Uint8*>(converted->pixels) + static_cast<size_t>(y) * converted->pitch,
+                asset.info.pitch);
+        }
+        SDL_DestroySurface(converted);
+
+        assets.push_back(std::move(asset));
+        return true;
+    }
+
+    bool packFile(const std::string& path, const std::string& name, AssetType type, std::vector<PackedAsset>& assets) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            std::cerr << "Skipping " << path << ": can't open" << std::endl;
+            return false;
+        }
+
+        PackedAsset asset;
+        asset.name = name;
+        asset.info = { type, nullptr, 0, 0, 0, 0, 0 };
+        asset.bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        assets.push_back(std::move(asset));
+        return true;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string outPath = "assets.pak";
+    std::string bakedDir = FontManager::getBakedDirectory();
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+            outPath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--baked-dir") == 0 && i + 1 < argc) {
+            bakedDir = argv[++i];
+        }
+    }
+
+    std::vector<PackedAsset> assets;
+    bool complete = true;
+    for (size_t i = 0; i < static_cast<size_t>(SpriteId::COUNT); i++) {
+        const char* path = SpriteAtlas::getSourcePath(static_cast<SpriteId>(i));
+        // A missing image is drawn procedurally in game, so it's not an error
+        if (path) packImage(path, assets);
+    }
+    for (const std::string& path : FontManager::getFontPaths()) {
+        complete = packFile(path, path, AssetType::FONT, assets) && complete;
+    }
+    // Sheets from bake_fonts; without one the game falls back to the TTF
+    for (const auto& style : FontManager::getBuiltInStyles()) {
+        std::string name = FontManager::getBakedName(style.first, style.second);
+        packFile(bakedDir + "/" + name, name, AssetType::BAKED_FONT, assets);
+    }
+    SDL_Quit();
+
+    if (!AssetArchive::write(outPath, assets)) {
+        return 1;
+    }
+
+    size_t total = 0;
+    for (const PackedAsset& asset : assets) {
+        std::cout << "  " << asset.name << " (" << asset.bytes.size() / 1024 << " KB)" << std::endl;
+        total += asset.bytes.size();
+    }
+    std::cout << "Wrote " << assets.size() << " assets, " << total / 1024 << " KB, to " << outPath << std::endl;
+    return complete ? 0 : 1;
+}